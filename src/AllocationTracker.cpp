@@ -0,0 +1,104 @@
+/**
+ * @file AllocationTracker.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the heap allocation tracking and the global operator new
+ * replacement.
+ */
+#include "AllocationTracker.h"
+
+#ifdef TRACK_ALLOCATIONS
+
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <new>
+
+#include "Logger.h"
+
+namespace {
+
+// trivially initialized, so they are safe to touch from operator new
+thread_local bool tracking = false;
+thread_local unsigned long allocations = 0;
+// allocations of every thread's frames since the latest reset
+std::atomic<unsigned long> steady{0};
+
+void *allocate(std::size_t size) {
+  if (tracking) {
+    allocations++;
+#ifdef TRAP_ALLOCATIONS
+#ifdef SIGTRAP
+    raise(SIGTRAP);
+#else
+    abort();
+#endif
+#endif
+  }
+  return malloc(size == 0 ? 1 : size);
+}
+
+};  // namespace
+
+void *operator new(std::size_t size) {
+  void *ptr = allocate(size);
+  if (ptr == NULL) throw std::bad_alloc();
+  return ptr;
+}
+
+void *operator new[](std::size_t size) {
+  void *ptr = allocate(size);
+  if (ptr == NULL) throw std::bad_alloc();
+  return ptr;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size);
+}
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete[](void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { free(ptr); }
+
+namespace allocation {
+
+FrameScope::FrameScope() : previous{tracking}, start{allocations} {
+  tracking = true;
+}
+
+FrameScope::~FrameScope() {
+  tracking = previous;
+  unsigned long made = allocations - start;
+  if (made > 0) {
+    steady.fetch_add(made, std::memory_order_relaxed);
+    logger::log(logger::level::WARNING, "%lu heap allocations during a frame",
+                made);
+  }
+}
+
+Exempt::Exempt() : previous{tracking} { tracking = false; }
+
+Exempt::~Exempt() { tracking = previous; }
+
+unsigned long count() { return allocations; }
+
+void reset() { steady.store(0, std::memory_order_relaxed); }
+
+bool check() {
+  unsigned long made = steady.load(std::memory_order_relaxed);
+  if (made > 0)
+    logger::log(logger::level::ERROR,
+                "%lu heap allocations during steady state frames", made);
+  return made == 0;
+}
+
+};  // namespace allocation
+
+#endif
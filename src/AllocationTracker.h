@@ -0,0 +1,102 @@
+/**
+ * @file AllocationTracker.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the scopes used to track heap allocations within a frame.
+ */
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+/**
+ * @brief Relates to tracking heap allocations in the frame loop.
+ *
+ * When built with TRACK_ALLOCATIONS defined, the global operator new is
+ * replaced to count the allocations each thread makes inside a FrameScope, and
+ * a warning is logged for every frame that allocated. The allocations of
+ * every thread's frames since the latest reset() are also summed, so that
+ * check() can fail a benchmark run whose steady state allocates. Defining
+ * TRAP_ALLOCATIONS as well raises SIGTRAP on the offending allocation, so a
+ * debugger stops right at it.
+ *
+ * Otherwise, the scopes compile to nothing and every check passes.
+ */
+namespace allocation {
+
+#ifdef TRACK_ALLOCATIONS
+
+/**
+ * @brief Marks the lifetime of a frame in which no heap allocation is
+ * expected on the current thread.
+ */
+class FrameScope {
+  bool previous;
+  unsigned long start;
+
+ public:
+  FrameScope();
+  FrameScope(const FrameScope &) = delete;
+  FrameScope &operator=(const FrameScope &) = delete;
+  /**
+   * @brief Logs the amount of allocations made within the scope, if any.
+   */
+  ~FrameScope();
+};
+
+/**
+ * @brief Excludes a section of a FrameScope from tracking, for allocations
+ * that are known and accepted.
+ */
+class Exempt {
+  bool previous;
+
+ public:
+  Exempt();
+  Exempt(const Exempt &) = delete;
+  Exempt &operator=(const Exempt &) = delete;
+  ~Exempt();
+};
+
+/**
+ * @brief Get the amount of tracked allocations made by the current thread.
+ *
+ * @return the amount of allocations made inside frame scopes so far
+ */
+unsigned long count();
+
+/**
+ * @brief Discard the allocations summed so far, once the frame loop reached
+ * its steady state.
+ */
+void reset();
+
+/**
+ * @brief Check that no frame of any thread allocated since the latest reset,
+ * logging an error otherwise.
+ *
+ * @return true if no frame allocated, otherwise false
+ */
+bool check();
+
+#else
+
+class FrameScope {
+ public:
+  FrameScope() {}
+};
+
+class Exempt {
+ public:
+  Exempt() {}
+};
+
+inline unsigned long count() { return 0; }
+inline void reset() {}
+inline bool check() { return true; }
+
+#endif
+
+};  // namespace allocation
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file Assets.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the functions for finding the assets embedded into the
+ * game.
+ */
+#include "Assets.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "Tracer.h"
+
+namespace assets {
+
+namespace {
+
+std::string overrideDir;
+// files preloaded from disk, by relative path, never erased so that their
+// bytes stay in place
+std::map<std::string, std::vector<unsigned char>> preloaded;
+std::mutex preloadedMutex;
+
+/**
+ * @brief Strips the leading "./" the game's paths are written with.
+ */
+const char *relative(const char *path) {
+  while (strncmp(path, "./", 2) == 0) path += 2;
+  return path;
+}
+
+/**
+ * @brief Check whether or not an asset is overridden on disk.
+ */
+bool overridden(const char *path, std::string &found) {
+  if (overrideDir.empty()) return false;
+  found = overrideDir + "/" + relative(path);
+  FILE *file = fopen(found.c_str(), "rb");
+  if (file == NULL) return false;
+  fclose(file);
+  return true;
+}
+
+/**
+ * @brief Reads a whole file, in a single read.
+ */
+bool readFile(const std::string &path, std::vector<unsigned char> &data) {
+  tracer::Scope trace{"READ ASSET"};
+  FILE *file = fopen(path.c_str(), "rb");
+  if (file == NULL) return false;
+  long size = -1;
+  if (fseek(file, 0, SEEK_END) == 0) size = ftell(file);
+  bool ok = size >= 0 && fseek(file, 0, SEEK_SET) == 0;
+  if (ok) {
+    data.resize(size);
+    ok = fread(data.data(), 1, size, file) == (size_t)size;
+  }
+  fclose(file);
+  return ok;
+}
+
+/**
+ * @brief Finds an asset in the embedded table.
+ */
+const Embedded *lookup(const char *path) {
+  const char *name = relative(path);
+  for (const Embedded *asset = embedded; asset->path != NULL; asset++)
+    if (strcmp(asset->path, name) == 0) return asset;
+  return NULL;
+}
+
+};  // namespace
+
+void setOverrides(const char *dir) { overrideDir = dir != NULL ? dir : ""; }
+
+/**
+ * Without an override directory, this is a lookup in a table of a handful of
+ * entries.
+ */
+const Embedded *find(const char *path) {
+  std::string found;
+  return overridden(path, found) ? NULL : lookup(path);
+}
+
+std::string diskPath(const char *path) {
+  std::string found;
+  return overridden(path, found) ? found : std::string{path};
+}
+
+/**
+ * Preloaded files are looked up first, as they were already read from
+ * wherever they were found.
+ */
+bool read(const char *path, Blob &blob) {
+  {
+    std::lock_guard<std::mutex> lock{preloadedMutex};
+    auto file = preloaded.find(relative(path));
+    if (file != preloaded.end()) {
+      blob.data = file->second.data();
+      blob.size = file->second.size();
+      return true;
+    }
+  }
+
+  std::string found;
+  if (!overridden(path, found)) {
+    const Embedded *asset = lookup(path);
+    if (asset != NULL) {
+      blob.data = asset->data;
+      blob.size = asset->size;
+      return true;
+    }
+    found = path;
+  }
+
+  if (!readFile(found, blob.storage)) return false;
+  blob.data = blob.storage.data();
+  blob.size = blob.storage.size();
+  return true;
+}
+
+void preload(const char *path) {
+  if (find(path) != NULL) return;
+  std::vector<unsigned char> data;
+  if (!readFile(diskPath(path), data)) return;
+  std::lock_guard<std::mutex> lock{preloadedMutex};
+  preloaded.emplace(relative(path), std::move(data));
+}
+
+};  // namespace assets
@@ -0,0 +1,122 @@
+/**
+ * @file Assets.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the functions for finding the assets embedded into the
+ * game.
+ */
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Relates to the shaders, font atlas and sound bank compiled into the
+ * game.
+ *
+ * The build embeds every asset as an aligned byte array, already decoded: the
+ * shaders as text, the font as its preprocessed atlas and the sounds as PCM
+ * samples. Finding an embedded asset does no file I/O at all, so the game
+ * runs from a single file in any directory.
+ *
+ * Assets are found by the relative path the game always loaded them from.
+ * Once assets::setOverrides is given a directory, files present under it are
+ * preferred over the embedded ones, so they can be edited without a rebuild.
+ * Assets missing from the build are read from the working directory, and can
+ * be preloaded off the main thread.
+ *
+ * @see tools/embed_assets.cpp
+ */
+namespace assets {
+
+/**
+ * @brief An asset compiled into the game.
+ */
+struct Embedded {
+  // relative path of the asset's source, without a leading "./"
+  const char *path;
+  // decoded bytes, followed by a null byte not counted in size
+  const unsigned char *data;
+  size_t size;
+  // sounds: channels, sample rate and bits per sample
+  int channels;
+  unsigned int rate;
+  int bits;
+};
+
+/**
+ * @brief Every embedded asset, ending with an entry of null path.
+ *
+ * Generated at build time into EmbeddedAssets.cpp.
+ */
+extern const Embedded embedded[];
+
+/**
+ * @brief Bytes of an asset, either embedded or read from disk.
+ */
+struct Blob {
+  const unsigned char *data = NULL;
+  size_t size = 0;
+  // holds the bytes of a file read from disk
+  std::vector<unsigned char> storage;
+};
+
+/**
+ * @brief Prefers files found under a directory over the embedded assets.
+ *
+ * @param dir directory the relative paths of the assets are looked up from,
+ * or null to use the embedded assets only
+ *
+ * Must be called before any asset is looked up.
+ */
+void setOverrides(const char *dir);
+
+/**
+ * @brief Finds an embedded asset, unless overridden on disk.
+ *
+ * @param path relative path of the asset
+ *
+ * @return the embedded asset, or null if it must be read from disk
+ *
+ * @see assets::diskPath
+ */
+const Embedded *find(const char *path);
+
+/**
+ * @brief Gets the path an asset not found embedded is read from.
+ *
+ * @param path relative path of the asset
+ *
+ * @return the path under the override directory if the file is there,
+ * otherwise the path itself
+ */
+std::string diskPath(const char *path);
+
+/**
+ * @brief Reads the bytes of an asset, embedded or from disk.
+ *
+ * @param path relative path of the asset
+ * @param blob filled with the bytes, which for embedded assets are not
+ * copied
+ *
+ * @return whether or not the asset was found
+ */
+bool read(const char *path, Blob &blob);
+
+/**
+ * @brief Reads an asset that isn't embedded into memory ahead of its use.
+ *
+ * @param path relative path of the asset
+ *
+ * Later calls to assets::read get the bytes without any file I/O. Embedded
+ * assets are left as they are. Safe to call from any thread.
+ */
+void preload(const char *path);
+
+};  // namespace assets
+
+#endif
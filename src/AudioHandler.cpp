@@ -8,10 +8,84 @@
  */
 #include "AudioHandler.h"
 
+#include <cmath>
+
+#include "Assets.h"
+#include "Logger.h"
+#include "Tracer.h"
+
+/**
+ * The pan is taken from the horizontal angle between the listener's right
+ * direction and the direction to the source, ranging from -1 (left) to 1
+ * (right), and mapped onto a quarter circle so that the summed power of both
+ * channels stays constant.
+ */
+void positionalGains(const glm::vec3 &source, const glm::vec3 &listenerPos,
+                     const glm::vec3 &listenerRight, double volume,
+                     float &gainLeft, float &gainRight) {
+  glm::vec3 toSource = source - listenerPos;
+  float distance = glm::length(toSource);
+
+  float pan = 0.0f;
+  if (distance > 0.0001f)
+    pan = glm::clamp(glm::dot(toSource / distance, listenerRight), -1.0f, 1.0f);
+
+  float attenuation = 1.0f;
+  if (distance > audioConstants::ref_distance)
+    attenuation = audioConstants::ref_distance /
+                  (audioConstants::ref_distance +
+                   audioConstants::rolloff *
+                       (distance - audioConstants::ref_distance));
+
+  float angle = (pan + 1.0f) * (float)M_PI / 4.0f;
+  gainLeft = (float)volume * attenuation * cosf(angle);
+  gainRight = (float)volume * attenuation * sinf(angle);
+}
+
+void scalePeriod(int16_t *samples, unsigned long count, double volume) {
+  for (unsigned long i = 0; i < count; ++i) {
+    samples[i] = static_cast<int16_t>(samples[i] * volume);
+  }
+}
+
+void mixPeriod(const int16_t *in, int16_t *out, unsigned long frames,
+               int inChannels, float gainLeft, float gainRight) {
+  if (inChannels == 1) {
+    for (unsigned long i = 0; i < frames; ++i) {
+      out[2 * i] = static_cast<int16_t>(in[i] * gainLeft);
+      out[2 * i + 1] = static_cast<int16_t>(in[i] * gainRight);
+    }
+  } else {
+    for (unsigned long i = 0; i < frames; ++i) {
+      out[2 * i] = static_cast<int16_t>(in[2 * i] * gainLeft);
+      out[2 * i + 1] = static_cast<int16_t>(in[2 * i + 1] * gainRight);
+    }
+  }
+}
+
+bool AudioHandler::playAudio(const std::string &filePath, double volume) {
+  return play(filePath, volume, NULL);
+}
+
+bool AudioHandler::playAudio(const std::string &filePath, double volume,
+                             const glm::vec3 &source) {
+  return play(filePath, volume, &source);
+}
+
+void AudioHandler::setListener(const Camera &camera) {
+  listenerPos = camera.getPosition();
+  listenerRight = camera.getRight();
+}
+
+void AudioHandler::activateAudio() { play_audio = true; }
+void AudioHandler::stopAudio() { play_audio = false; }
+
 #ifdef __linux__
 #include <alsa/asoundlib.h>
 
+#include <cerrno>
 #include <cstdio>
+#include <cstring>
 
 /**
  * @brief Data related to a .wav file
@@ -26,7 +100,10 @@ struct wav_file_data {
   unsigned short BytesPerSample;
   unsigned long DataSize;
   unsigned long ListSize;
+  // the file the samples are read from, or null for embedded samples
   FILE *SampledData;
+  const unsigned char *EmbeddedData;
+  unsigned long Position;
 };
 
 /**
@@ -34,106 +111,130 @@ struct wav_file_data {
  *
  * @param file_path path to the .wav file
  * @param data to be filled from header
+ * @param file filled with the file's bytes, which the samples are then read
+ * from
  *
  * @return whether or not the operation was a success
+ *
+ * Preloaded files are read without any file I/O.
+ *
+ * @see assets::preload
  */
-bool wav_read(const char *file_path, wav_file_data *data) {
+bool wav_read(const char *file_path, wav_file_data *data, assets::Blob &file) {
+  tracer::Scope trace{"LOAD WAV"};
   FILE *audio;
   int nread;
   char riff[4], wave[4], fmt_id[4], data_id[4];
   unsigned long bloc_size = 0;
 
-  audio = fopen(file_path, "rb");
+  if (!assets::read(file_path, file)) {
+    logger::log(logger::level::ERROR, "Audio file %s couldn't be opened: %s",
+                file_path, strerror(errno));
+    return false;
+  }
+  audio = fmemopen(const_cast<unsigned char *>(file.data), file.size, "rb");
   if (audio == NULL) {
-    fprintf(stderr, "Audio file %s couldn't be opened: ", file_path);
-    perror("");
+    logger::log(logger::level::ERROR, "Audio file %s couldn't be read: %s",
+                file_path, strerror(errno));
     return false;
   }
 
   nread = fread(riff, 1, 4, audio);
   if (nread < 4) {
-    fprintf(stderr, "File couldn't be properly read: fields 1-4\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 1-4");
     return false;
   }
 
   if (!(riff[0] == 'R' && riff[1] == 'I' && riff[2] == 'F' && riff[3] == 'F')) {
-    fprintf(stderr, "Invalid file: not a RIFF file.\n");
+    logger::log(logger::level::ERROR, "Invalid file: not a RIFF file.");
     return false;
   }
 
   nread = fread(&data->FileSize, 4, 1, audio);
   if (nread < 1) {
-    fprintf(stderr, "File couldn't be properly read: fields 5-8\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 5-8");
     return false;
   }
 
   nread = fread(wave, 1, 4, audio);
   if (nread < 4) {
-    fprintf(stderr, "File couldn't be properly read: fields 9-12\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 9-12");
     return false;
   }
 
   if (!(wave[0] == 'W' && wave[1] == 'A' && wave[2] == 'V' && wave[3] == 'E')) {
-    fprintf(stderr, "Invalid file: not a WAVE file.\n");
+    logger::log(logger::level::ERROR, "Invalid file: not a WAVE file.");
     return false;
   }
 
   nread = fread(fmt_id, 1, 4, audio);
   if (nread < 4) {
-    fprintf(stderr, "File couldn't be properly read: fields 13-16\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 13-16");
     return false;
   }
 
   if (!(fmt_id[0] == 'f' && fmt_id[1] == 'm' && fmt_id[2] == 't' &&
         fmt_id[3] == ' ')) {
-    fprintf(stderr, "Invalid file: format id missing.\n");
+    logger::log(logger::level::ERROR, "Invalid file: format id missing.");
     return false;
   }
 
   nread = fread(&bloc_size, 4, 1, audio);
   if (nread < 1) {
-    fprintf(stderr, "File couldn't be properly read: fields 17-20\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 17-20");
     return false;
   }
 
   if (bloc_size != 16) {
-    printf("Invalid format block size of size %lu.\n", bloc_size);
+    logger::log(logger::level::ERROR,
+                "Invalid format block size of size %lu.", bloc_size);
     return false;
   }
 
   nread = fread(&data->AudioFormat, 2, 1, audio);
   if (nread < 1) {
-    fprintf(stderr, "File couldn't be properly read: fields 21-22\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 21-22");
     return false;
   }
 
   nread = fread(&data->NbrChannels, 2, 1, audio);
   if (nread < 1) {
-    fprintf(stderr, "File couldn't be properly read: fields 23-24\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 23-24");
     return false;
   }
 
   nread = fread(&data->Frequence, 4, 1, audio);
   if (nread < 1) {
-    fprintf(stderr, "File couldn't be properly read: fields 25-28\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 25-28");
     return false;
   }
 
   nread = fread(&data->BytesPerSec, 4, 1, audio);
   if (nread < 1) {
-    fprintf(stderr, "File couldn't be properly read: fields 29-32\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 29-32");
     return false;
   }
 
   nread = fread(&data->BytesPerBloc, 2, 1, audio);
   if (nread < 1) {
-    fprintf(stderr, "File couldn't be properly read: fields 33-34\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 33-34");
     return false;
   }
 
   nread = fread(&data->BytesPerSample, 2, 1, audio);
   if (nread < 1) {
-    fprintf(stderr, "File couldn't be properly read: fields 35-36\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 35-36");
     return false;
   }
 
@@ -141,7 +242,8 @@ bool wav_read(const char *file_path, wav_file_data *data) {
   for (;;) {
     nread = fread(data_id, 1, 4, audio);
     if (nread < 4) {
-      fprintf(stderr, "File couldn't be properly read: fields 37-40\n");
+      logger::log(logger::level::ERROR,
+                  "File couldn't be properly read: fields 37-40");
       return false;
     }
 
@@ -150,7 +252,8 @@ bool wav_read(const char *file_path, wav_file_data *data) {
       unsigned long list_size = 0;
       nread = fread(&list_size, 4, 1, audio);
       if (nread < 1) {
-        fprintf(stderr, "File couldn't be properly read: LIST field\n");
+        logger::log(logger::level::ERROR,
+                    "File couldn't be properly read: LIST field");
         return false;
       }
 
@@ -161,13 +264,14 @@ bool wav_read(const char *file_path, wav_file_data *data) {
 
   if (!(data_id[0] == 'd' && data_id[1] == 'a' && data_id[2] == 't' &&
         data_id[3] == 'a')) {
-    fprintf(stderr, "Invalid file: data id missing.\n");
+    logger::log(logger::level::ERROR, "Invalid file: data id missing.");
     return false;
   }
 
   nread = fread(&data->DataSize, 4, 1, audio);
   if (nread < 1) {
-    fprintf(stderr, "File couldn't be properly read: fields 41-44\n");
+    logger::log(logger::level::ERROR,
+                "File couldn't be properly read: fields 41-44");
     return false;
   }
 
@@ -176,63 +280,119 @@ bool wav_read(const char *file_path, wav_file_data *data) {
   return true;
 }
 
-bool AudioHandler::playAudio(const std::string &filePath, double volume) {
+/**
+ * @brief Fills a .wav file's header data from an embedded sound.
+ *
+ * @param sound the embedded sound, decoded into its samples
+ * @param data to be filled as if read from the file's header
+ */
+void wav_embedded(const assets::Embedded *sound, wav_file_data *data) {
+  data->AudioFormat = 1;
+  data->NbrChannels = sound->channels;
+  data->Frequence = sound->rate;
+  data->BytesPerBloc = sound->channels * sound->bits / 8;
+  data->BytesPerSec = sound->rate * data->BytesPerBloc;
+  data->BytesPerSample = sound->bits;
+  data->DataSize = sound->size;
+  data->SampledData = NULL;
+  data->EmbeddedData = sound->data;
+  data->Position = 0;
+}
+
+/**
+ * @brief Reads the next samples of a .wav file, from disk or memory.
+ *
+ * @param data the file's header data
+ * @param buf filled with the samples
+ * @param size maximum amount of bytes to be read
+ *
+ * @return the amount of bytes read
+ */
+size_t wav_fetch(wav_file_data *data, char *buf, size_t size) {
+  if (data->SampledData != NULL)
+    return fread(buf, sizeof(char), size, data->SampledData);
+
+  size_t left = data->DataSize - data->Position;
+  if (size > left) size = left;
+  memcpy(buf, data->EmbeddedData + data->Position, size);
+  data->Position += size;
+  return size;
+}
+
+bool AudioHandler::play(const std::string &filePath, double volume,
+                        const glm::vec3 *source) {
   wav_file_data data{};
   int err;
   double seconds;
-  char *buf;
+  char *buf, *mix = NULL;
   snd_pcm_t *playback_handle;
   snd_pcm_hw_params_t *hw_params;
 
-  if (!wav_read(filePath.c_str(), &data)) return false;
+  const assets::Embedded *sound = assets::find(filePath.c_str());
+  assets::Blob file;
+  if (sound != NULL)
+    wav_embedded(sound, &data);
+  else if (!wav_read(filePath.c_str(), &data, file))
+    return false;
 
   seconds = (double)data.DataSize / data.BytesPerSec;
 
+  // only mono and stereo files can be panned
+  if (data.NbrChannels > 2) source = NULL;
+  unsigned int out_channels = source ? 2 : data.NbrChannels;
+
   if ((err = snd_pcm_open(&playback_handle, audioConstants::pcm_device.c_str(),
                           SND_PCM_STREAM_PLAYBACK, 0)) < 0) {
-    fprintf(stderr, "cannot open audio device %s (%s)\n",
-            audioConstants::pcm_device.c_str(), snd_strerror(err));
+    logger::log(logger::level::ERROR, "cannot open audio device %s (%s)",
+                audioConstants::pcm_device.c_str(), snd_strerror(err));
     return false;
   }
 
   if ((err = snd_pcm_hw_params_malloc(&hw_params)) < 0) {
-    fprintf(stderr, "cannot allocate hardware parameter structure (%s)\n",
-            snd_strerror(err));
+    logger::log(logger::level::ERROR,
+                "cannot allocate hardware parameter structure (%s)",
+                snd_strerror(err));
     return false;
   }
 
   if ((err = snd_pcm_hw_params_any(playback_handle, hw_params)) < 0) {
-    fprintf(stderr, "cannot initialize hardware parameter structure (%s)\n",
-            snd_strerror(err));
+    logger::log(logger::level::ERROR,
+                "cannot initialize hardware parameter structure (%s)",
+                snd_strerror(err));
     return false;
   }
 
   if ((err = snd_pcm_hw_params_set_access(playback_handle, hw_params,
                                           SND_PCM_ACCESS_RW_INTERLEAVED)) < 0) {
-    fprintf(stderr, "cannot set access type (%s)\n", snd_strerror(err));
+    logger::log(logger::level::ERROR,
+                "cannot set access type (%s)", snd_strerror(err));
     return false;
   }
 
   if ((err = snd_pcm_hw_params_set_format(playback_handle, hw_params,
                                           SND_PCM_FORMAT_S16_LE)) < 0) {
-    fprintf(stderr, "cannot set sample format (%s)\n", snd_strerror(err));
+    logger::log(logger::level::ERROR,
+                "cannot set sample format (%s)", snd_strerror(err));
     return false;
   }
 
   if ((err = snd_pcm_hw_params_set_rate_near(playback_handle, hw_params,
                                              &data.Frequence, 0)) < 0) {
-    fprintf(stderr, "cannot set sample rate (%s)\n", snd_strerror(err));
+    logger::log(logger::level::ERROR,
+                "cannot set sample rate (%s)", snd_strerror(err));
     return false;
   }
 
   if ((err = snd_pcm_hw_params_set_channels(playback_handle, hw_params,
-                                            data.NbrChannels)) < 0) {
-    fprintf(stderr, "cannot set channel count (%s)\n", snd_strerror(err));
+                                            out_channels)) < 0) {
+    logger::log(logger::level::ERROR,
+                "cannot set channel count (%s)", snd_strerror(err));
     return false;
   }
 
   if ((err = snd_pcm_hw_params(playback_handle, hw_params)) < 0) {
-    fprintf(stderr, "cannot set parameters (%s)\n", snd_strerror(err));
+    logger::log(logger::level::ERROR,
+                "cannot set parameters (%s)", snd_strerror(err));
     return false;
   }
 
@@ -253,30 +413,53 @@ bool AudioHandler::playAudio(const std::string &filePath, double volume) {
   buf = new char[buf_size];
 
   if (buf == NULL) {
-    fprintf(stderr, "bad alloc\n");
+    logger::log(logger::level::ERROR, "bad alloc");
     return false;
   }
 
+  if (source) {
+    mix = new char[frames * out_channels * sampwidth];
+    if (mix == NULL) {
+      logger::log(logger::level::ERROR, "bad alloc");
+      return false;
+    }
+  }
+
   snd_pcm_hw_params_free(hw_params);
 
+  // the source stays in place for the whole play, so its gains are computed
+  // once instead of for every sample
+  float gainLeft = 0.0f, gainRight = 0.0f;
+  if (source)
+    positionalGains(*source, listenerPos, listenerRight, volume, gainLeft,
+                    gainRight);
+
   for (unsigned long i = (int)(seconds * 1000000) / tmp; i > 0 && play_audio;
        i--) {
+    tracer::Scope trace{"AUDIO PERIOD"};
     int read;
-    if ((read = fread(buf, sizeof(char), buf_size, data.SampledData)) == 0) {
-      printf("Premature end of file.\n");
+    if ((read = wav_fetch(&data, buf, buf_size)) == 0) {
+      logger::log(logger::level::WARNING, "Premature end of file.");
       break;
     }
 
     int16_t *samples = reinterpret_cast<int16_t *>(buf);
-    for (int i = 0; i < read / sampwidth; ++i) {
-      samples[i] = static_cast<int16_t>(samples[i] * volume);
+    if (source) {
+      mixPeriod(samples, reinterpret_cast<int16_t *>(mix),
+                read / (sampwidth * data.NbrChannels), data.NbrChannels,
+                gainLeft, gainRight);
+    } else {
+      scalePeriod(samples, read / sampwidth, volume);
     }
 
-    if ((err = snd_pcm_writei(playback_handle, buf, frames)) == -EPIPE) {
-      printf("XRUN.\n");
+    if ((err = snd_pcm_writei(playback_handle, source ? mix : buf, frames)) ==
+        -EPIPE) {
+      logger::log(logger::level::WARNING, "XRUN.");
+      tracer::instant("XRUN");
       snd_pcm_prepare(playback_handle);
     } else if (err < 0) {
-      fprintf(stderr, "cannot write to pcm device (%s)\n", snd_strerror(err));
+      logger::log(logger::level::ERROR,
+                  "cannot write to pcm device (%s)", snd_strerror(err));
       return false;
     }
   }
@@ -285,21 +468,18 @@ bool AudioHandler::playAudio(const std::string &filePath, double volume) {
   snd_pcm_close(playback_handle);
 
   delete[] buf;
-  fclose(data.SampledData);
+  delete[] mix;
+  if (data.SampledData != NULL) fclose(data.SampledData);
 
   return play_audio;
 }
 
-void AudioHandler::activateAudio() { play_audio = true; }
-void AudioHandler::stopAudio() { play_audio = false; }
-
 #else
 
-bool AudioHandler::playAudio(const std::string &filePath, double volume) {
+bool AudioHandler::play(const std::string &filePath, double volume,
+                        const glm::vec3 *source) {
   return false;
 }
-void AudioHandler::activateAudio() { play_audio = true; }
-void AudioHandler::stopAudio() { play_audio = false; }
 
 #endif
 
@@ -8,15 +8,71 @@
  */
 #ifndef AUDIO_HANDLER_H
 #define AUDIO_HANDLER_H
+#include <cstdint>
 #include <string>
 
+#include "camera.h"
 #include "constants.h"
 
+/**
+ * @brief Computes the left and right channel gains of a positional sound.
+ *
+ * @param source position of the sound in 3D space
+ * @param listenerPos position of the listener in 3D space
+ * @param listenerRight normalized right direction of the listener
+ * @param volume the base volume of play, ranging from 0.0 to 1.0
+ * @param gainLeft filled with the gain for the left channel
+ * @param gainRight filled with the gain for the right channel
+ *
+ * Uses constant-power panning, along with inverse distance attenuation
+ * according to audioConstants::ref_distance and audioConstants::rolloff.
+ */
+void positionalGains(const glm::vec3 &source, const glm::vec3 &listenerPos,
+                     const glm::vec3 &listenerRight, double volume,
+                     float &gainLeft, float &gainRight);
+
+/**
+ * @brief Scales a period of samples by a volume, in place.
+ *
+ * @param samples the samples to be scaled
+ * @param count amount of samples, across every channel
+ * @param volume the volume of play, ranging from 0.0 to 1.0
+ */
+void scalePeriod(int16_t *samples, unsigned long count, double volume);
+
+/**
+ * @brief Applies per-channel gains to a period of interleaved samples.
+ *
+ * @param in interleaved input samples
+ * @param out interleaved stereo output samples
+ * @param frames amount of frames in the period
+ * @param inChannels amount of channels in the input, either 1 or 2
+ * @param gainLeft gain for the left channel
+ * @param gainRight gain for the right channel
+ *
+ * A mono input is spread into both output channels.
+ */
+void mixPeriod(const int16_t *in, int16_t *out, unsigned long frames,
+               int inChannels, float gainLeft, float gainRight);
+
 /**
  * @brief Defines the methods for playing .wav audio files.
  */
 class AudioHandler {
   bool play_audio;
+  glm::vec3 listenerPos, listenerRight;
+
+  /**
+   * @brief Plays a .wav audio, optionally panned from a position in space.
+   *
+   * @param filePath the path of the .wav file
+   * @param volume the desired volume of play, ranging from 0.0 to 1.0
+   * @param source position of the sound, or null for non-positional play
+   *
+   * @return the value of play_audio
+   */
+  bool play(const std::string &filePath, double volume,
+            const glm::vec3 *source);
 
  public:
   /**
@@ -25,9 +81,12 @@ class AudioHandler {
    * @param _play_audio whether or not audio should be played on call
    *
    */
-  AudioHandler(bool _play_audio = true) : play_audio{_play_audio} {}
-  AudioHandler(const AudioHandler& other) = delete;
-  AudioHandler& operator=(const AudioHandler&) = delete;
+  AudioHandler(bool _play_audio = true)
+      : play_audio{_play_audio},
+        listenerPos{glm::vec3(0.0f, 0.0f, 0.0f)},
+        listenerRight{glm::vec3(1.0f, 0.0f, 0.0f)} {}
+  AudioHandler(const AudioHandler &other) = delete;
+  AudioHandler &operator=(const AudioHandler &) = delete;
 
   /**
    * @brief Plays a .wav audio to the desired volume if play_audio is true.
@@ -40,7 +99,31 @@ class AudioHandler {
    * The function runs until completion of the file or until play_audio is
    * changed to false.
    */
-  bool playAudio(const std::string& filePath, double volume);
+  bool playAudio(const std::string &filePath, double volume);
+  /**
+   * @brief Plays a .wav audio as coming from the given position, panned and
+   * attenuated relative to the listener.
+   *
+   * @param filePath the path of the .wav file
+   * @param volume the desired volume of play, ranging from 0.0 to 1.0
+   * @param source position of the sound in 3D space
+   *
+   * @return the value of play_audio
+   *
+   * The output is always stereo, regardless of the file's channels.
+   *
+   * @see AudioHandler::setListener
+   */
+  bool playAudio(const std::string &filePath, double volume,
+                 const glm::vec3 &source);
+  /**
+   * @brief Sets the listener for positional audio from the Camera.
+   *
+   * @param camera the Camera the listener is attached to
+   *
+   * Must not be called while the handler is playing.
+   */
+  void setListener(const Camera &camera);
   /**
    * @brief Enables audio playback. Changes play_audio to true.
    */
@@ -0,0 +1,176 @@
+/**
+ * @file Board.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Defines and implements the class for the board's geometry.
+ */
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <algorithm>
+#include <cmath>
+
+#include "Include/glm/glm.hpp"
+#include "constants.h"
+
+/**
+ * @brief Defines the geometry of the board the game is played on.
+ *
+ * The board is a grid of cells, centered on the origin, with width cells
+ * along the x axis and height cells along the z axis, each side holding from
+ * boardConstants::min_side to boardConstants::max_side cells. Every other
+ * position of the game, from the Snake's borders to the camera, derives from
+ * it.
+ */
+class Board {
+  using SELF = Board;
+
+  int width, height;
+
+ public:
+  /**
+   * @brief Constructor for the Board.
+   *
+   * @param _width amount of cells along the x axis
+   * @param _height amount of cells along the z axis
+   */
+  explicit Board(int _width = boardConstants::default_side,
+                 int _height = boardConstants::default_side)
+      : width{std::min(std::max(_width, boardConstants::min_side),
+                       boardConstants::max_side)},
+        height{std::min(std::max(_height, boardConstants::min_side),
+                        boardConstants::max_side)} {}
+
+  /**
+   * @brief Get the amount of cells along the x axis.
+   *
+   * @return the board's width
+   */
+  int getWidth() const { return width; }
+  /**
+   * @brief Get the amount of cells along the z axis.
+   *
+   * @return the board's height
+   */
+  int getHeight() const { return height; }
+  /**
+   * @brief Get the amount of cells of the board.
+   *
+   * @return the board's area
+   */
+  long area() const { return (long)width * height; }
+  /**
+   * @brief Get the most parts a Snake can start with on the board.
+   *
+   * The Snake starts laid out along a row, so it has to fit in one without
+   * running into itself, and leave a cell free for the Point.
+   *
+   * @return the longest starting length
+   */
+  int maxStartLength() const {
+    return (int)std::min((long)width, area() - 1);
+  }
+
+  /**
+   * @brief Get the distance from the center to the x edges.
+   *
+   * @return half of the board's extent along the x axis
+   */
+  float halfX() const { return width * modelConstants::scale_factor / 2; }
+  /**
+   * @brief Get the distance from the center to the z edges.
+   *
+   * @return half of the board's extent along the z axis
+   */
+  float halfZ() const { return height * modelConstants::scale_factor / 2; }
+  /**
+   * @brief Get the x coordinate of the outermost cell centers.
+   *
+   * @return the border given to the Snake along the x axis
+   */
+  float borderX() const { return halfX() - modelConstants::scale_factor / 2; }
+  /**
+   * @brief Get the z coordinate of the outermost cell centers.
+   *
+   * @return the border given to the Snake along the z axis
+   */
+  float borderZ() const { return halfZ() - modelConstants::scale_factor / 2; }
+
+  /**
+   * @brief Get the position of an object standing on a cell.
+   *
+   * @param x the cell's column, from 0 to width - 1
+   * @param z the cell's row, from 0 to height - 1
+   *
+   * @return the cell's center, raised onto the plane's surface
+   */
+  glm::vec3 cell(int x, int z) const {
+    return glm::vec3(
+        modelConstants::scale_factor * x + modelConstants::scale_factor / 2 -
+            halfX(),
+        modelConstants::scale_factor / 2 - 0.995f,
+        modelConstants::scale_factor * z + modelConstants::scale_factor / 2 -
+            halfZ());
+  }
+  /**
+   * @brief Get the cell an object stands on, the inverse of Board::cell.
+   *
+   * @param trans the object's position
+   *
+   * @return the cell's column and row
+   */
+  glm::ivec2 cellOf(const glm::vec3 &trans) const {
+    return glm::ivec2(
+        (int)std::lround((trans.x + halfX()) / modelConstants::scale_factor -
+                         0.5f),
+        (int)std::lround((trans.z + halfZ()) / modelConstants::scale_factor -
+                         0.5f));
+  }
+  /**
+   * @brief Get the position of an object standing on the middle cell.
+   *
+   * @return the middle cell's center, raised onto the plane's surface
+   */
+  glm::vec3 center() const { return cell((width - 1) / 2, (height - 1) / 2); }
+
+  /**
+   * @brief Get the camera's position, framing the whole board.
+   *
+   * The default board's framing is kept, scaled along with its longest side.
+   *
+   * @return the camera's position 3D vector
+   */
+  glm::vec3 cameraPosition() const {
+    return glm::vec3(0.0f, -1.0f, 0.0f) +
+           boardConstants::camera_offset * std::max(halfX(), halfZ());
+  }
+  /**
+   * @brief Get the factor the clipping planes are scaled by, so that boards
+   * larger than the default one stay in view.
+   *
+   * @return the factor, at least 1
+   */
+  float viewScale() const {
+    return std::max(1.0f, std::max(halfX(), halfZ()));
+  }
+
+  /**
+   * @brief Get the amount of Snake parts to reserve memory for up front.
+   *
+   * Filling a large board would take more memory than is reasonable to
+   * reserve, so beyond boardConstants::max_reserved_parts the Snake grows
+   * its memory as needed.
+   *
+   * @param length the Snake's starting length
+   *
+   * @return the amount of parts
+   */
+  size_t reservedParts(size_t length) const {
+    return std::max(length, (size_t)std::min(
+                                area(), boardConstants::max_reserved_parts));
+  }
+};
+
+#endif
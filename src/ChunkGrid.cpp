@@ -0,0 +1,118 @@
+/**
+ * @file ChunkGrid.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class for the board's render chunks.
+ */
+#include "ChunkGrid.h"
+
+#include <algorithm>
+
+#include "GLStats.h"
+#include "Include/glm/gtc/matrix_transform.hpp"
+
+using SELF = ChunkGrid;
+
+namespace {
+
+const int chunk_side = boardConstants::chunk_side;
+const float chunk_size = chunk_side * modelConstants::scale_factor;
+
+};  // namespace
+
+ChunkGrid::ChunkGrid(const Board &_board)
+    : board{_board},
+      columns{(_board.getWidth() + chunk_side - 1) / chunk_side},
+      rows{(_board.getHeight() + chunk_side - 1) / chunk_side},
+      visible((size_t)columns * rows, 1),
+      visibleChunks{(unsigned long)columns * rows},
+      changed{true} {}
+
+/**
+ * The box spans from the bottom of the plane to the top of a cube standing on
+ * it, and the last chunk of a row or column is cut short at the board's edge.
+ */
+glm::vec3 ChunkGrid::chunkMin(int column, int row) const {
+  return glm::vec3(column * chunk_size - board.halfX(), -1.1f,
+                   row * chunk_size - board.halfZ());
+}
+
+glm::vec3 ChunkGrid::chunkMax(int column, int row) const {
+  const float scale = modelConstants::scale_factor;
+  return glm::vec3(
+      std::min((column + 1) * chunk_side, board.getWidth()) * scale -
+          board.halfX(),
+      -1.0f + scale,
+      std::min((row + 1) * chunk_side, board.getHeight()) * scale -
+          board.halfZ());
+}
+
+SELF &ChunkGrid::cull(const Frustum &frustum) {
+  visibleChunks = 0;
+  changed = false;
+  for (int row = 0; row < rows; row++)
+    for (int column = 0; column < columns; column++) {
+      bool seen = frustum.intersects(chunkMin(column, row),
+                                     chunkMax(column, row));
+      unsigned char &chunk = visible[(size_t)row * columns + column];
+      changed |= chunk != seen;
+      chunk = seen;
+      visibleChunks += seen;
+    }
+  return *this;
+}
+
+bool ChunkGrid::isVisible(const glm::vec3 &position) const {
+  int column = (int)((position.x + board.halfX()) / chunk_size);
+  int row = (int)((position.z + board.halfZ()) / chunk_size);
+  column = std::min(std::max(column, 0), columns - 1);
+  row = std::min(std::max(row, 0), rows - 1);
+  return visible[(size_t)row * columns + column];
+}
+
+unsigned long ChunkGrid::getVisibleChunks() const { return visibleChunks; }
+
+bool ChunkGrid::visibilityChanged() const { return changed; }
+
+unsigned long ChunkGrid::getChunkCount() const {
+  return (unsigned long)columns * rows;
+}
+
+/**
+ * The plane mesh must be bound and a shader program must be active before
+ * this function is called. The mesh spans from -1 to 1, so it is scaled by
+ * half of each run's extent and moved onto the run's center.
+ * @see Mesh
+ * @see Shader
+ */
+SELF &ChunkGrid::drawPlane(const Mesh &mesh, GLint location) {
+  for (int row = 0; row < rows; row++) {
+    int column = 0;
+    while (column < columns) {
+      if (!visible[(size_t)row * columns + column]) {
+        glstats::countInstance(false);
+        column++;
+        continue;
+      }
+      int first = column;
+      while (column < columns && visible[(size_t)row * columns + column]) {
+        glstats::countInstance(true);
+        column++;
+      }
+
+      glm::vec3 min = chunkMin(first, row), max = chunkMax(column - 1, row);
+      glm::mat4 model = glm::translate(
+          glm::mat4(1.0f),
+          glm::vec3((min.x + max.x) / 2, 0.0f, (min.z + max.z) / 2));
+      model = glm::rotate(model, glm::radians(-90.0f),
+                          glm::vec3(1.0f, 0.0f, 0.0f));
+      model = glm::scale(model, glm::vec3((max.x - min.x) / 2,
+                                          (max.z - min.z) / 2, 1.0f));
+
+      mesh.draw(model, location);
+    }
+  }
+  return *this;
+}
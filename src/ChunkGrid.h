@@ -0,0 +1,120 @@
+/**
+ * @file ChunkGrid.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class for the board's render chunks.
+ */
+#ifndef CHUNK_GRID_H
+#define CHUNK_GRID_H
+
+#include <vector>
+
+#include "Board.h"
+#include "Frustum.h"
+#include "Include/glad/glad.h"
+#include "Include/glm/glm.hpp"
+#include "MeshRegistry.h"
+
+/**
+ * @brief Defines the methods for splitting the board into square chunks and
+ * culling them against the view frustum.
+ *
+ * Each chunk spans boardConstants::chunk_side cells along each side, and is
+ * bounded by a box from the bottom of the plane to the top of the objects
+ * standing on it. Objects are culled along with the chunk they stand on.
+ */
+class ChunkGrid {
+  using SELF = ChunkGrid;
+
+  Board board;
+  int columns, rows;
+  std::vector<unsigned char> visible;
+  unsigned long visibleChunks;
+  bool changed;
+
+  /**
+   * @brief Get the lowest corner of a chunk's bounding box.
+   *
+   * @param column the chunk's column
+   * @param row the chunk's row
+   *
+   * @return the corner's position
+   */
+  glm::vec3 chunkMin(int column, int row) const;
+  /**
+   * @brief Get the highest corner of a chunk's bounding box.
+   *
+   * @param column the chunk's column
+   * @param row the chunk's row
+   *
+   * @return the corner's position
+   */
+  glm::vec3 chunkMax(int column, int row) const;
+
+ public:
+  /**
+   * @brief Constructor for the ChunkGrid, with every chunk visible.
+   *
+   * @param _board the board to be split
+   */
+  explicit ChunkGrid(const Board &_board);
+
+  /**
+   * @brief Update which chunks are visible.
+   *
+   * @param frustum the view frustum
+   *
+   * @return reference to the object
+   */
+  SELF &cull(const Frustum &frustum);
+
+  /**
+   * @brief Check whether or not an object standing on the board is in a
+   * visible chunk.
+   *
+   * @param position the object's position
+   *
+   * @return true if it is the case, otherwise false
+   */
+  bool isVisible(const glm::vec3 &position) const;
+
+  /**
+   * @brief Get the amount of chunks found visible by the latest culling.
+   *
+   * @return the amount of visible chunks
+   */
+  unsigned long getVisibleChunks() const;
+  /**
+   * @brief Check whether or not the latest culling changed which chunks are
+   * visible, or the grid is yet to be culled.
+   *
+   * @return true if it is the case, otherwise false
+   */
+  bool visibilityChanged() const;
+  /**
+   * @brief Get the amount of chunks of the board.
+   *
+   * @return the amount of chunks
+   */
+  unsigned long getChunkCount() const;
+
+  /**
+   * @brief Draw the plane under every visible chunk.
+   *
+   * Neighboring visible chunks of a row are drawn together, stretching the
+   * plane mesh over them, so that a fully visible board takes one draw per
+   * row of chunks.
+   *
+   * @param mesh the plane mesh, bound
+   * @param location location of the active program's model matrix uniform
+   *
+   * @return reference to the object
+   *
+   * @see Shader::location
+   */
+  SELF &drawPlane(const Mesh &mesh, GLint location);
+};
+
+#endif
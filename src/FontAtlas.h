@@ -0,0 +1,69 @@
+/**
+ * @file FontAtlas.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Defines the format of the preprocessed font atlas.
+ */
+#ifndef FONT_ATLAS_H
+#define FONT_ATLAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Relates to the font atlas converted from the font bitmap at build
+ * time.
+ *
+ * An atlas file is a Header followed by one byte of coverage per texel, row
+ * by row from the bottom, as GL textures expect. It is uploaded as is into a
+ * single channel texture, with no decoding at all.
+ *
+ * @see tools/embed_assets.cpp
+ */
+namespace atlas {
+
+// identifies atlas files, and the version of their format
+const char magic[4] = {'S', '3', 'D', 'A'};
+const uint32_t version = 1;
+
+/**
+ * @brief Dimensions and glyph metrics of an atlas, in native byte order.
+ */
+struct Header {
+  char magic[4];
+  uint32_t version;
+  // dimensions of the atlas, in texels
+  uint32_t width, height;
+  // dimensions of each glyph, in texels
+  uint32_t glyphWidth, glyphHeight;
+  // positions of the first number and the first letter, from the top left
+  // and counting rightwards
+  uint32_t numberSeqStart, letterSeqStart;
+};
+
+/**
+ * @brief Check an atlas and find its texels.
+ *
+ * @param data the atlas' bytes
+ * @param size amount of bytes
+ * @param header filled with the atlas' header
+ *
+ * @return the texels, or null if the atlas is invalid or truncated
+ */
+inline const unsigned char *parse(const unsigned char *data, size_t size,
+                                  Header &header) {
+  if (data == NULL || size < sizeof(Header)) return NULL;
+  memcpy(&header, data, sizeof(Header));
+  if (memcmp(header.magic, magic, sizeof(magic)) != 0 ||
+      header.version != version ||
+      size - sizeof(Header) < (size_t)header.width * header.height)
+    return NULL;
+  return data + sizeof(Header);
+}
+
+};  // namespace atlas
+
+#endif
@@ -8,47 +8,80 @@
  */
 #include "FontRenderer.h"
 
+#include <cstddef>
+#include <cstring>
+
+#include "FontAtlas.h"
+#include "GLStats.h"
+#include "Logger.h"
+#include "Tracer.h"
+
 using SELF = FontRenderer;
 
+namespace {
+
+/**
+ * @brief A vertex of a streamed character quad.
+ */
+struct GlyphVertex {
+  glm::vec3 position;
+  glm::vec2 texCoord;
+};
+
+};  // namespace
+
 /**
- * The texture shifts occurs based on the given positions, which are then
- * converted into coordinates according to the character and image dimensions.
+ * The character's position is given by the sequence starting positions,
+ * counting rightwards from the top left, and then converted into coordinates
+ * according to the character and image dimensions.
  *
- * The coordinates are then passed to the uniform.
+ * Only letters and numbers are available.
  */
-SELF& FontRenderer::shiftTexture(const std::string& uniformName, int xpos,
-                                 int ypos) {
-  glm::vec2 finalPos{(float)xpos * xsize / width,
-                     1.0f - (float)(ypos * ysize - 1) / height};
-  fontShader.setv2fv(uniformName, finalPos);
-  return *this;
+bool GlyphLayout::charTexPos(const char c, glm::vec2 &texPos) const {
+  int temp_pos;
+  if (c >= '0' && c <= '9')
+    temp_pos = numberSequenceStart + c - '0';
+  else if (c >= 'a' && c <= 'z')
+    temp_pos = letterSequenceStart + c - 'a';
+  else if (c >= 'A' && c <= 'Z')
+    temp_pos = letterSequenceStart + c - 'A';
+  else
+    return false;
+  int xpos = temp_pos % (width / xsize);
+  int ypos = temp_pos / (width / xsize);
+  texPos = glm::vec2((float)xpos * xsize / width,
+                     1.0f - (float)(ypos * ysize - 1) / height);
+  return true;
 }
 
 /**
- * The font bitmap file is loaded and its width and height extracted.
+ * The atlas' dimensions and glyph metrics are taken from its header, and its
+ * texels are uploaded as they are into a single channel texture.
  *
- * In the case the file is invalid, the error is logged to the terminal.
+ * In the case the atlas is invalid, the error is logged to the terminal.
  */
-FontRenderer::FontRenderer(const char* fontPath, unsigned int textureNo,
-                           GLenum format, const Shape3D& _quadFontShape,
-                           const Shader& _fontShader,
-                           const std::string& fontTexUniformName, int _xsize,
-                           int _ysize, int number_seq_start,
-                           int letter_seq_start)
-    : numberSequenceStart{number_seq_start},
-      letterSequenceStart{letter_seq_start},
-      quadFontShape{_quadFontShape},
-      fontShader{_fontShader} {
+FontRenderer::FontRenderer(const assets::Blob &atlas, unsigned int textureNo,
+                           const Mesh &_quadMesh, const Shader &_fontShader,
+                           const std::string &fontTexUniformName,
+                           StreamBuffer *_stream)
+    : quadMesh{_quadMesh},
+      fontShader{_fontShader},
+      stream{_stream} {
+  tracer::Scope trace{"LOAD FONT"};
   fontShader.use();
   No = GL_TEXTURE0 + textureNo;
-  xsize = _xsize;
-  ysize = _ysize;
+  // overwritten by the loaded atlas' metrics
+  glyphs.xsize = fontConstants::font_char_width;
+  glyphs.ysize = fontConstants::font_char_height;
+  glyphs.numberSequenceStart = fontConstants::number_seq_start;
+  glyphs.letterSequenceStart = fontConstants::letter_seq_start;
+  glyphs.width = fontConstants::bitmap_width;
+  glyphs.height = fontConstants::bitmap_height;
 
-  quadFontShape.bind();
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+  // streamed quads are pointed at when drawn, as their offset changes
+  glGenVertexArrays(1, &glyphVAO);
+  glBindVertexArray(glyphVAO);
   glEnableVertexAttribArray(0);
-  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float),
-                        (void*)(3 * sizeof(float)));
   glEnableVertexAttribArray(1);
 
   glGenTextures(1, &ID);
@@ -56,88 +89,128 @@ FontRenderer::FontRenderer(const char* fontPath, unsigned int textureNo,
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-  int nrChannels;
-  stbi_set_flip_vertically_on_load(true);
-  unsigned char* data = stbi_load(fontPath, &width, &height, &nrChannels, 0);
-  if (data) {
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, format,
-                 GL_UNSIGNED_BYTE, data);
+  atlas::Header header;
+  const unsigned char *texels = atlas::parse(atlas.data, atlas.size, header);
+  if (texels != NULL) {
+    glyphs.width = header.width;
+    glyphs.height = header.height;
+    glyphs.xsize = header.glyphWidth;
+    glyphs.ysize = header.glyphHeight;
+    glyphs.numberSequenceStart = header.numberSeqStart;
+    glyphs.letterSequenceStart = header.letterSeqStart;
+    // rows of single bytes aren't padded to 4 bytes
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, glyphs.width, glyphs.height, 0,
+                 GL_RED, GL_UNSIGNED_BYTE, texels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
   } else {
-    std::cout << "Failed to load texture at " << fontPath << std::endl;
+    logger::log(logger::level::ERROR, "Invalid font atlas");
   }
-  stbi_image_free(data);
 
-  fontShader.setInt(fontTexUniformName, 0);
+  fontShader.setInt(fontTexUniformName.c_str(), 0);
 }
 
 /**
- * The shift occurs based on the given character and the sequence starting
- * position, which are then converted to x and y axis positions.
- *
- * The function only accepts letters and numbers. Given otherwise, an error will
- * be logged to the terminal.
+ * The function only accepts letters and numbers. Given otherwise, a warning
+ * will be logged.
  */
-SELF& FontRenderer::shiftToChar(const char c, const std::string& uniformName) {
-  int temp_pos;
-  if (c >= '0' && c <= '9')
-    temp_pos = numberSequenceStart + c - '0';
-  else if (c >= 'a' && c <= 'z')
-    temp_pos = letterSequenceStart + c - 'a';
-  else if (c >= 'A' && c <= 'Z')
-    temp_pos = letterSequenceStart + c - 'A';
-  else {
-    std::cout << "Character \'" << c << "\' is unavailable." << std::endl;
+SELF &FontRenderer::shiftToChar(const char c, const char *uniformName) {
+  glm::vec2 texPos;
+  if (!glyphs.charTexPos(c, texPos)) {
+    logger::log(logger::level::WARNING, "Character \'%c\' is unavailable.",
+                c);
     return *this;
   }
-  int posx = temp_pos % (width / xsize);
-  int posy = temp_pos / (width / xsize);
-  return shiftTexture(uniformName, posx, posy);
+  fontShader.setv2fv(uniformName, texPos);
+  return *this;
 }
 
 /**
- * The text is written character by character, with the given gap between
- * characters and lines.
- *
- * A y line gap is given by a new line character in the string, and a space
- * character is handled as an extra gap.
+ * Each quad is built from modelConstants::vertices_quad, transformed by its
+ * model matrix and shifted to its character, so the shader gets an identity
+ * model and no texture offset.
  */
-SELF& FontRenderer::writeText(const std::string& text, float scaleFactor,
+bool FontRenderer::streamText(const char *text, float scaleFactor,
                               float startingPosX, float startingPosY,
                               float xgap, float ygap,
-                              const std::string& textUniformName,
-                              const std::string& modelUniformName) {
-  glm::mat4 updatePos = glm::mat4(1.0f);
-  updatePos = glm::scale(updatePos,
-                         glm::vec3(scaleFactor, scaleFactor, scaleFactor));
-  updatePos = glm::translate(updatePos,
-                             glm::vec3(startingPosX, startingPosY, 0.0f));
-  const glm::vec3 gapVec = glm::vec3(xgap, 0.0f, 0.0f);
+                              const char *textUniformName,
+                              const char *modelUniformName) {
+  const size_t quadVertices = sizeof(modelConstants::indices_quad) /
+                              sizeof(modelConstants::indices_quad[0]);
+  StreamBuffer::Allocation allocation =
+      stream->allocate(strlen(text) * quadVertices * sizeof(GlyphVertex));
+  if (allocation.data == NULL) return false;
 
+  GlyphVertex *vertices = (GlyphVertex *)allocation.data;
+  GLsizei count = 0;
+  auto emit = [&](const glm::mat4 &model, const glm::vec2 &texPos) {
+    for (GLuint index : modelConstants::indices_quad) {
+      const float *vertex = &modelConstants::vertices_quad[index * 5];
+      vertices[count].position =
+          glm::vec3(model * glm::vec4(vertex[0], vertex[1], vertex[2], 1.0f));
+      vertices[count].texCoord = glm::vec2(vertex[3], vertex[4]) + texPos;
+      count++;
+    }
+  };
+  glyphs.layout(text, scaleFactor, startingPosX, startingPosY, xgap, ygap,
+                emit);
+  stream->unmap();
+  if (count == 0) return true;
+
+  glBindVertexArray(glyphVAO);
+  glBindBuffer(GL_ARRAY_BUFFER, stream->getVBO());
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex),
+                        (void *)(allocation.offset +
+                                 offsetof(GlyphVertex, position)));
+  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex),
+                        (void *)(allocation.offset +
+                                 offsetof(GlyphVertex, texCoord)));
+  fontShader.setm4fv(modelUniformName, glm::mat4(1.0f));
+  fontShader.setv2fv(textUniformName, glm::vec2(0.0f));
+  glstats::countDraw();
+  glDrawArrays(GL_TRIANGLES, 0, count);
+  return true;
+}
+
+/**
+ * The text is laid out by GlyphLayout::layout, and streamed if possible, or
+ * otherwise drawn with one draw per character. Either way, the text is walked
+ * in place, so no memory is allocated.
+ */
+SELF &FontRenderer::writeText(const char *text, float scaleFactor,
+                              float startingPosX, float startingPosY,
+                              float xgap, float ygap,
+                              const char *textUniformName,
+                              const char *modelUniformName) {
   active();
   bind();
   fontShader.use();
-  quadFontShape.bind();
-  for (size_t i = 0; i < text.size(); i++) {
-    if (text[i] == '\n')
-      return writeText(text.substr(++i), scaleFactor, startingPosX,
-                       startingPosY - ygap, xgap, ygap, textUniformName,
-                       modelUniformName);
-    if (text[i] != ' ') {
-      fontShader.setm4fv(modelUniformName, updatePos);
-      shiftToChar(text[i], textUniformName);
-      glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    }
-    updatePos = glm::translate(updatePos, gapVec);
-  }
+  if (stream != NULL &&
+      streamText(text, scaleFactor, startingPosX, startingPosY, xgap, ygap,
+                 textUniformName, modelUniformName))
+    return *this;
+
+  quadMesh.bind();
+  glyphs.layout(text, scaleFactor, startingPosX, startingPosY, xgap, ygap,
+                [&](const glm::mat4 &model, const glm::vec2 &texPos) {
+                  fontShader.setm4fv(modelUniformName, model);
+                  fontShader.setv2fv(textUniformName, texPos);
+                  glstats::countDraw();
+                  quadMesh.draw();
+                });
   return *this;
 }
 
-SELF& FontRenderer::bind() {
+const GlyphLayout &FontRenderer::getLayout() const { return glyphs; }
+
+SELF &FontRenderer::bind() {
   glBindTexture(GL_TEXTURE_2D, ID);
   return *this;
 }
 
-SELF& FontRenderer::active() {
+SELF &FontRenderer::active() {
   glActiveTexture(No);
   return *this;
 }
+
+FontRenderer::~FontRenderer() { glDeleteVertexArrays(1, &glyphVAO); }
@@ -9,75 +9,141 @@
 #ifndef FONT_RENDERER_H
 #define FONT_RENDERER_H
 
-#include <iostream>
+#include <string>
 
+#include "Assets.h"
 #include "Include/glad/glad.h"
 #include "Include/glm/glm.hpp"
+#include "Include/glm/gtc/matrix_transform.hpp"
 #include "Include/glm/gtc/type_ptr.hpp"
-#include "Include/stb_image/stb_image.h"
-#include "Shape3D.h"
+#include "Logger.h"
+#include "MeshRegistry.h"
+#include "StreamBuffer.h"
 #include "constants.h"
 #include "shader.h"
 
+/**
+ * @brief Defines where the characters of a bitmap font lie, both in the
+ * bitmap and on screen, independently of any GL state.
+ *
+ * @see FontRenderer
+ */
+struct GlyphLayout {
+  int width, height;
+  int xsize, ysize;
+  int numberSequenceStart, letterSequenceStart;
+
+  /**
+   * @brief Get the texture coordinate offset of a character.
+   *
+   * @param c the character
+   * @param texPos filled with the offset to be added to the quad's texture
+   * coordinates
+   *
+   * @return whether or not the character is available in the font
+   */
+  bool charTexPos(const char c, glm::vec2 &texPos) const;
+
+  /**
+   * @brief Lay text out, character by character.
+   *
+   * @param text null-terminated string of text to be laid out
+   * @param scaleFactor scaling for the font size
+   * @param startingPosX starting position of the first character in the x axis
+   * @param startingPosY starting position of the first character in the y axis
+   * @param xgap the gap between character in the x axis
+   * @param ygap the gap between lines in the y axis
+   * @param emit called as emit(model, texPos) for each character to be drawn,
+   * with its quad's 4D model matrix and texture coordinate offset
+   *
+   * A y line gap is given by a new line character in the string, and a space
+   * character is handled as an extra gap. Unavailable characters are skipped
+   * and a warning is logged.
+   */
+  template <typename Emit>
+  void layout(const char *text, float scaleFactor, float startingPosX,
+              float startingPosY, float xgap, float ygap, Emit emit) const {
+    const glm::mat4 scaled = glm::scale(
+        glm::mat4(1.0f), glm::vec3(scaleFactor, scaleFactor, scaleFactor));
+    glm::mat4 updatePos = glm::translate(
+        scaled, glm::vec3(startingPosX, startingPosY, 0.0f));
+    const glm::vec3 gapVec = glm::vec3(xgap, 0.0f, 0.0f);
+
+    for (const char *c = text; *c != '\0'; c++) {
+      if (*c == '\n') {
+        startingPosY -= ygap;
+        updatePos = glm::translate(
+            scaled, glm::vec3(startingPosX, startingPosY, 0.0f));
+        continue;
+      }
+      if (*c != ' ') {
+        glm::vec2 texPos;
+        if (charTexPos(*c, texPos))
+          emit(updatePos, texPos);
+        else
+          logger::log(logger::level::WARNING,
+                      "Character \'%c\' is unavailable.", *c);
+      }
+      updatePos = glm::translate(updatePos, gapVec);
+    }
+  }
+};
+
 /**
  * @brief Defines the methods for reading a bitmap font and drawing it on
  * screen.
  *
- * @see Shape3D
+ * Given a StreamBuffer, each text is laid out into quads on the CPU and drawn
+ * with a single call. Otherwise, each character is drawn with its own.
+ *
+ * @see Mesh
  * @see Shader
  */
 class FontRenderer {
   using SELF = FontRenderer;
-  int numberSequenceStart, letterSequenceStart;
-  Shape3D quadFontShape;
+  GlyphLayout glyphs;
+  Mesh quadMesh;
   Shader fontShader;
+  StreamBuffer *stream;
+  GLuint glyphVAO;
 
   /**
-   * @brief Shifts the texture coordinates by an amount of characters in the x
-   * and y axes.
+   * @brief Draw text with a single call, from quads streamed for it.
    *
-   * @param uniformName uniform name for a 2D vector in the shaders for texture
-   * @param xpos position of the character in the x axis, starting at 0
-   * @param ypos position of the character in the y axis, starting at 0
+   * @return whether or not the text could be streamed
    *
-   * @return reference to the object
+   * @see writeText
    */
-  SELF& shiftTexture(const std::string& uniformName, int xpos, int ypos);
+  bool streamText(const char *text, float scaleFactor, float startingPosX,
+                  float startingPosY, float xgap, float ygap,
+                  const char *textUniformName, const char *modelUniformName);
 
  public:
   GLuint ID;
   GLenum No;
-  int width, height;
-  int xsize, ysize;
 
   /**
    * @brief Constructor for the font renderer.
    *
-   * @param fontPath file path for the bitmap font file
+   * @param atlas the font's preprocessed atlas
    * @param textureNo given texture number, starting at 0
-   * @param format the format of GL color representation, e.g. GL_RGB
-   * @param _quadFontShape the Shape3D for a quad, composed of two triangles
+   * @param _quadMesh the Mesh for a quad, composed of two triangles, with
+   * positions and texture coordinates
    * @param _fontShader the Shader associated with the font
    * @param fontTexUniformName the uniform name for the font texture in the
    * shader
-   * @param _xsize the width of each character in the font file
-   * @param _ysize the height of each character in the font file
-   * @param number_seq_start the position of the first number, starting from 0
-   * from the top left and counting rightwards
-   * @param letter_seq_start the position of the first letter, starting from 0
-   * from the top left and counting rightwards
-   *
-   * @see Shape3D
+   * @param _stream buffer to stream the text's quads through, if any
+   *
+   * @see FontAtlas.h
+   * @see Mesh
    * @see Shader
    */
-  FontRenderer(const char* fontPath, unsigned int textureNo, GLenum format,
-               const Shape3D& _quadFontShape, const Shader& _fontShader,
-               const std::string& fontTexUniformName,
-               int _xsize = fontConstants::font_char_width,
-               int _ysize = fontConstants::font_char_height,
-               int number_seq_start = fontConstants::number_seq_start,
-               int letter_seq_start = fontConstants::letter_seq_start);
-  FontRenderer(const FontRenderer&) = delete;
+  FontRenderer(const assets::Blob &atlas, unsigned int textureNo,
+               const Mesh &_quadMesh, const Shader &_fontShader,
+               const std::string &fontTexUniformName,
+               StreamBuffer *_stream = NULL);
+  FontRenderer(const FontRenderer &) = delete;
+  FontRenderer &operator=(const FontRenderer &) = delete;
 
   /**
    * @brief Shift the texture coordinates to the given character
@@ -88,14 +154,14 @@ class FontRenderer {
    *
    * @return reference to the object
    *
-   * @see FontRenderer::shiftTexture
+   * @see GlyphLayout::charTexPos
    */
-  SELF& shiftToChar(const char c, const std::string& uniformName);
+  SELF &shiftToChar(const char c, const char *uniformName);
 
   /**
    * Write text to the screen.
    *
-   * @param text string of text to be written
+   * @param text null-terminated string of text to be written
    * @param scaleFactor scaling for the font size
    * @param startingPosX starting position of the first character in the x axis
    * @param startingPosY starting position of the first character in the y axis
@@ -107,27 +173,38 @@ class FontRenderer {
    *
    * @return reference to the object
    *
-   * @see FontRenderer::shiftToChar
-   * @see FontRenderer::shiftTexture
+   * @see GlyphLayout::layout
    */
-  SELF& writeText(const std::string& text, float scaleFactor,
-                  float startingPosX, float startingPosY, float xgap,
-                  float ygap, const std::string& textUniformName,
-                  const std::string& modelUniformName);
+  SELF &writeText(const char *text, float scaleFactor, float startingPosX,
+                  float startingPosY, float xgap, float ygap,
+                  const char *textUniformName, const char *modelUniformName);
+
+  /**
+   * @brief Get the layout of the font's characters.
+   *
+   * @return the font's GlyphLayout
+   */
+  const GlyphLayout &getLayout() const;
 
   /**
    * @brief Bind the font texture.
    *
    * @return reference to the object
    */
-  SELF& bind();
+  SELF &bind();
 
   /**
    * @brief Activate the font texture.
    *
    * @return reference to the object
    */
-  SELF& active();
+  SELF &active();
+
+  /**
+   * @brief Destructor for the font renderer, deleting the streamed quads'
+   * vertex array.
+   */
+  ~FontRenderer();
 };
 
 #endif
@@ -0,0 +1,82 @@
+/**
+ * @file FrameLimiter.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class for frame pacing.
+ */
+#include "FrameLimiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "Logger.h"
+#include "Tracer.h"
+#include "constants.h"
+
+using SELF = FrameLimiter;
+
+FrameLimiter::FrameLimiter(double fps)
+    : period{fps > 0 ? std::chrono::duration_cast<clock::duration>(
+                           std::chrono::duration<double>(1.0 / fps))
+                     : clock::duration::zero()},
+      started{false},
+      frames{0},
+      overruns{0},
+      jitterSum{0.0},
+      jitterSquares{0.0},
+      jitterMax{0.0} {}
+
+/**
+ * The first call only sets the first deadline, as there's no frame before it
+ * to pace.
+ */
+SELF &FrameLimiter::wait() {
+  if (period == clock::duration::zero()) return *this;
+
+  clock::time_point now = clock::now();
+  if (!started) {
+    started = true;
+    deadline = now + period;
+    return *this;
+  }
+
+  if (now >= deadline) {
+    overruns++;
+    deadline = now + period;
+    return *this;
+  }
+
+  tracer::Scope trace{"FRAME LIMIT"};
+  const auto margin = std::chrono::microseconds(frameConstants::spin_margin_us);
+  if (deadline - now > margin)
+    std::this_thread::sleep_until(deadline - margin);
+  while ((now = clock::now()) < deadline) std::this_thread::yield();
+
+  std::chrono::duration<double, std::micro> late = now - deadline;
+  frames++;
+  jitterSum += late.count();
+  jitterSquares += late.count() * late.count();
+  if (late.count() > jitterMax) jitterMax = late.count();
+
+  deadline += period;
+  return *this;
+}
+
+SELF &FrameLimiter::report(const char *name) {
+  unsigned long total = frames + overruns;
+  if (period == clock::duration::zero() || total == 0) return *this;
+
+  double avg = frames > 0 ? jitterSum / frames : 0.0;
+  double deviation =
+      frames > 0 ? std::sqrt(std::max(0.0, jitterSquares / frames - avg * avg))
+                 : 0.0;
+  std::chrono::duration<double, std::milli> ms = period;
+  logger::log(logger::level::INFO,
+              "%s paced at %.3f ms: %lu frames, %lu overran, jitter avg %.1f "
+              "us, stddev %.1f us, max %.1f us",
+              name, ms.count(), total, overruns, avg, deviation, jitterMax);
+  return *this;
+}
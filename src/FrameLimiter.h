@@ -0,0 +1,61 @@
+/**
+ * @file FrameLimiter.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class for frame pacing.
+ */
+#ifndef FRAME_LIMITER_H
+#define FRAME_LIMITER_H
+
+#include <chrono>
+
+/**
+ * @brief Defines the methods for capping the frame rate of a loop.
+ *
+ * Frames are paced against deadlines on the monotonic clock, one period
+ * apart. Waiting for a deadline sleeps until shortly before it, then spins
+ * for the remainder, since sleeping alone may overshoot by a whole scheduler
+ * quantum. A frame that overruns its deadline doesn't make the next ones
+ * hurry to catch up; the deadlines are restarted from it instead.
+ *
+ * The lateness of each wake up against its deadline is tracked as the
+ * frame's jitter.
+ */
+class FrameLimiter {
+  using SELF = FrameLimiter;
+  using clock = std::chrono::steady_clock;
+
+  clock::duration period;
+  clock::time_point deadline;
+  bool started;
+  unsigned long frames, overruns;
+  double jitterSum, jitterSquares, jitterMax;
+
+ public:
+  /**
+   * @brief Constructor for the FrameLimiter.
+   *
+   * @param fps the target frame rate, or 0 to not limit it
+   */
+  FrameLimiter(double fps);
+
+  /**
+   * @brief Wait until the end of the current frame's period.
+   *
+   * @return reference to the object
+   */
+  SELF &wait();
+
+  /**
+   * @brief Log the achieved pacing, if the frame rate is limited.
+   *
+   * @param name name of the paced loop
+   *
+   * @return reference to the object
+   */
+  SELF &report(const char *name);
+};
+
+#endif
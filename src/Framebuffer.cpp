@@ -0,0 +1,143 @@
+/**
+ * @file Framebuffer.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class for an offscreen framebuffer.
+ */
+#include "Framebuffer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Logger.h"
+#include "Tracer.h"
+
+using SELF = Framebuffer;
+
+Framebuffer::Framebuffer(int _width, int _height)
+    : width{_width}, height{_height} {
+  glGenFramebuffers(1, &FBO);
+  glGenRenderbuffers(1, &color);
+  glGenRenderbuffers(1, &depth);
+
+  glBindRenderbuffer(GL_RENDERBUFFER, color);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+  glBindRenderbuffer(GL_RENDERBUFFER, depth);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                            GL_RENDERBUFFER, color);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+                            GL_RENDERBUFFER, depth);
+  if (!complete())
+    logger::log(logger::level::ERROR, "Offscreen framebuffer is incomplete");
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+bool Framebuffer::complete() const {
+  glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+  return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+SELF &Framebuffer::bind() {
+  glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+  glViewport(0, 0, width, height);
+  return *this;
+}
+
+SELF &Framebuffer::blit(int windowWidth, int windowHeight) {
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+  glBlitFramebuffer(0, 0, width, height, 0, 0, windowWidth, windowHeight,
+                    GL_COLOR_BUFFER_BIT, GL_LINEAR);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glViewport(0, 0, windowWidth, windowHeight);
+  return *this;
+}
+
+/**
+ * OpenGL reads the rows starting from the bottom, so they are flipped to
+ * match the images' order.
+ */
+SELF &Framebuffer::read(std::vector<unsigned char> &pixels) {
+  tracer::Scope trace{"READBACK"};
+  const size_t row = (size_t)width * 3;
+  pixels.resize(row * height);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+  std::vector<unsigned char> swap(row);
+  for (int y = 0; y < height / 2; y++) {
+    unsigned char *top = &pixels[y * row];
+    unsigned char *bottom = &pixels[(height - 1 - y) * row];
+    memcpy(swap.data(), top, row);
+    memcpy(top, bottom, row);
+    memcpy(bottom, swap.data(), row);
+  }
+  return *this;
+}
+
+bool Framebuffer::save(const char *path) {
+  std::vector<unsigned char> pixels;
+  read(pixels);
+
+  FILE *file = fopen(path, "wb");
+  if (file == NULL) {
+    logger::log(logger::level::ERROR, "Couldn't open %s for writing", path);
+    return false;
+  }
+  fprintf(file, "P6\n%d %d\n255\n", width, height);
+  bool written = fwrite(pixels.data(), 1, pixels.size(), file) ==
+                 pixels.size();
+  fclose(file);
+  if (!written) logger::log(logger::level::ERROR, "Couldn't write %s", path);
+  return written;
+}
+
+long Framebuffer::compare(const char *path, int tolerance) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    logger::log(logger::level::ERROR, "Couldn't open %s", path);
+    return -1;
+  }
+  int imageWidth = 0, imageHeight = 0, maxValue = 0;
+  bool valid = fscanf(file, "P6 %d %d %d", &imageWidth, &imageHeight,
+                      &maxValue) == 3 &&
+               fgetc(file) != EOF && maxValue == 255;
+  if (!valid || imageWidth != width || imageHeight != height) {
+    logger::log(logger::level::ERROR,
+                "%s is not a %dx%d binary PPM image", path, width, height);
+    fclose(file);
+    return -1;
+  }
+  std::vector<unsigned char> golden((size_t)width * height * 3);
+  bool whole = fread(golden.data(), 1, golden.size(), file) == golden.size();
+  fclose(file);
+  if (!whole) {
+    logger::log(logger::level::ERROR, "%s is truncated", path);
+    return -1;
+  }
+
+  std::vector<unsigned char> pixels;
+  read(pixels);
+  long mismatches = 0;
+  for (size_t i = 0; i < pixels.size(); i += 3)
+    for (size_t c = 0; c < 3; c++)
+      if (abs(pixels[i + c] - golden[i + c]) > tolerance) {
+        mismatches++;
+        break;
+      }
+  return mismatches;
+}
+
+Framebuffer::~Framebuffer() {
+  glDeleteFramebuffers(1, &FBO);
+  glDeleteRenderbuffers(1, &color);
+  glDeleteRenderbuffers(1, &depth);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file Framebuffer.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class for an offscreen framebuffer.
+ */
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <vector>
+
+#include "Include/glad/glad.h"
+
+/**
+ * @brief Defines the methods for rendering into an offscreen framebuffer and
+ * reading its frames back.
+ *
+ * Frames are read back as tightly packed RGB rows, starting from the top row,
+ * and can be saved to or compared with binary PPM images.
+ */
+class Framebuffer {
+  using SELF = Framebuffer;
+
+  GLuint FBO, color, depth;
+  int width, height;
+
+ public:
+  /**
+   * @brief Constructor for the Framebuffer, with color and depth storage.
+   *
+   * @param _width width in pixels
+   * @param _height height in pixels
+   */
+  Framebuffer(int _width, int _height);
+  Framebuffer(const Framebuffer &) = delete;
+  Framebuffer &operator=(const Framebuffer &) = delete;
+
+  /**
+   * @brief Check whether or not the framebuffer can be rendered into.
+   *
+   * @return true if it is the case, otherwise false
+   */
+  bool complete() const;
+
+  /**
+   * @brief Get the framebuffer object's name.
+   *
+   * @return the name, to bind it for reading
+   */
+  GLuint getFBO() const { return FBO; }
+
+  /**
+   * @brief Render into the framebuffer, over its whole size.
+   *
+   * @return reference to the object
+   */
+  SELF &bind();
+  /**
+   * @brief Copy the framebuffer onto the window's, and render into the
+   * window's from then on.
+   *
+   * @param windowWidth the window's framebuffer width in pixels
+   * @param windowHeight the window's framebuffer height in pixels
+   *
+   * @return reference to the object
+   */
+  SELF &blit(int windowWidth, int windowHeight);
+
+  /**
+   * @brief Read the framebuffer's pixels back.
+   *
+   * @param pixels vector to be filled with RGB rows, starting from the top
+   *
+   * @return reference to the object
+   */
+  SELF &read(std::vector<unsigned char> &pixels);
+  /**
+   * @brief Save the framebuffer as a binary PPM image.
+   *
+   * @param path the image's path
+   *
+   * @return whether or not the image was saved
+   */
+  bool save(const char *path);
+  /**
+   * @brief Compare the framebuffer with a binary PPM image.
+   *
+   * @param path the reference image's path
+   * @param tolerance the largest difference allowed for any channel
+   *
+   * @return the amount of pixels differing beyond the tolerance, or -1 if
+   * the image couldn't be read or doesn't match the framebuffer's size
+   */
+  long compare(const char *path, int tolerance);
+
+  /**
+   * @brief Destructor for the Framebuffer, deleting the associated objects.
+   */
+  ~Framebuffer();
+};
+
+#endif
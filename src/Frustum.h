@@ -0,0 +1,70 @@
+/**
+ * @file Frustum.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Defines and implements the class for the view frustum.
+ */
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include "Include/glm/glm.hpp"
+
+/**
+ * @brief Defines the methods for testing whether or not boxes can be seen.
+ *
+ * The frustum is kept as its six planes, extracted straight from a view
+ * projection matrix, each with its normal pointing inwards.
+ */
+class Frustum {
+  using SELF = Frustum;
+
+  glm::vec4 planes[6];
+
+ public:
+  /**
+   * @brief Constructor for the Frustum.
+   *
+   * @param viewProjection the projection matrix times the view matrix
+   */
+  explicit Frustum(const glm::mat4 &viewProjection) {
+    // rows of the matrix, which glm stores by columns
+    glm::vec4 row[4];
+    for (int i = 0; i < 4; i++)
+      row[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i],
+                         viewProjection[2][i], viewProjection[3][i]);
+    for (int i = 0; i < 3; i++) {
+      planes[2 * i] = row[3] + row[i];
+      planes[2 * i + 1] = row[3] - row[i];
+    }
+  }
+
+  /**
+   * @brief Check whether or not an axis aligned box is at least partially
+   * within the frustum.
+   *
+   * The test is conservative: a box near a corner of the frustum may be
+   * reported as visible while being just outside of it.
+   *
+   * @param min the box's lowest corner
+   * @param max the box's highest corner
+   *
+   * @return true if the box may be seen, otherwise false
+   */
+  bool intersects(const glm::vec3 &min, const glm::vec3 &max) const {
+    for (const glm::vec4 &plane : planes) {
+      // the corner furthest along the plane's normal
+      glm::vec3 corner{plane.x >= 0 ? max.x : min.x,
+                       plane.y >= 0 ? max.y : min.y,
+                       plane.z >= 0 ? max.z : min.z};
+      if (plane.x * corner.x + plane.y * corner.y + plane.z * corner.z +
+              plane.w <
+          0)
+        return false;
+    }
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,276 @@
+/**
+ * @file GLRecorder.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the recording of OpenGL calls and the checking of per
+ * frame call budgets.
+ */
+#include "GLRecorder.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "Logger.h"
+
+#ifdef RECORD_GL
+
+#include "Include/glad/glad.h"
+
+namespace glrecord {
+
+namespace {
+
+// every recorded function, with the category it counts towards
+#define GL_CALLS(X)                          \
+  X(glDrawArrays, DRAW)                      \
+  X(glDrawElements, DRAW)                    \
+  X(glDrawElementsInstanced, DRAW)           \
+  X(glDrawElementsBaseVertex, DRAW)          \
+  X(glDrawElementsInstancedBaseVertex, DRAW) \
+  X(glGetUniformLocation, UNIFORM_LOOKUP)    \
+  X(glUniform1f, UNIFORM)                    \
+  X(glUniform1i, UNIFORM)                    \
+  X(glUniform2fv, UNIFORM)                   \
+  X(glUniform4fv, UNIFORM)                   \
+  X(glUniformMatrix4fv, UNIFORM)             \
+  X(glUseProgram, BIND)                      \
+  X(glBindVertexArray, BIND)                 \
+  X(glBindBuffer, BIND)                      \
+  X(glBindTexture, BIND)                     \
+  X(glBindFramebuffer, BIND)                 \
+  X(glBindRenderbuffer, BIND)                \
+  X(glActiveTexture, BIND)                   \
+  X(glBufferData, UPLOAD)                    \
+  X(glBufferSubData, UPLOAD)                 \
+  X(glTexImage2D, UPLOAD)                    \
+  X(glReadPixels, UPLOAD)                    \
+  X(glMapBufferRange, UPLOAD)                \
+  X(glUnmapBuffer, UPLOAD)                   \
+  X(glAttachShader, OTHER)                   \
+  X(glBeginQuery, OTHER)                     \
+  X(glBlitFramebuffer, OTHER)                \
+  X(glCheckFramebufferStatus, OTHER)         \
+  X(glClear, OTHER)                          \
+  X(glClientWaitSync, OTHER)                 \
+  X(glClearColor, OTHER)                     \
+  X(glCompileShader, OTHER)                  \
+  X(glCreateProgram, OTHER)                  \
+  X(glCreateShader, OTHER)                   \
+  X(glDeleteBuffers, OTHER)                  \
+  X(glDeleteFramebuffers, OTHER)             \
+  X(glDeleteProgram, OTHER)                  \
+  X(glDeleteQueries, OTHER)                  \
+  X(glDeleteRenderbuffers, OTHER)            \
+  X(glDeleteShader, OTHER)                   \
+  X(glDeleteSync, OTHER)                     \
+  X(glDeleteTextures, OTHER)                 \
+  X(glDeleteVertexArrays, OTHER)             \
+  X(glDetachShader, OTHER)                   \
+  X(glDisable, OTHER)                        \
+  X(glEnable, OTHER)                         \
+  X(glEnableVertexAttribArray, OTHER)        \
+  X(glEndQuery, OTHER)                       \
+  X(glFenceSync, OTHER)                      \
+  X(glFinish, OTHER)                         \
+  X(glFramebufferRenderbuffer, OTHER)        \
+  X(glGenBuffers, OTHER)                     \
+  X(glGenFramebuffers, OTHER)                \
+  X(glGenQueries, OTHER)                     \
+  X(glGenRenderbuffers, OTHER)               \
+  X(glGenTextures, OTHER)                    \
+  X(glGenVertexArrays, OTHER)                \
+  X(glGetProgramInfoLog, OTHER)              \
+  X(glGetProgramiv, OTHER)                   \
+  X(glGetQueryObjectiv, OTHER)               \
+  X(glGetQueryObjectui64v, OTHER)            \
+  X(glGetShaderInfoLog, OTHER)               \
+  X(glGetShaderiv, OTHER)                    \
+  X(glGetString, OTHER)                      \
+  X(glLinkProgram, OTHER)                    \
+  X(glPixelStorei, OTHER)                    \
+  X(glRenderbufferStorage, OTHER)            \
+  X(glShaderSource, OTHER)                   \
+  X(glTexParameteri, OTHER)                  \
+  X(glVertexAttribDivisor, OTHER)            \
+  X(glVertexAttribPointer, OTHER)            \
+  X(glViewport, OTHER)
+
+enum hookId {
+#define HOOK_ID(function, kind) function##_id,
+  GL_CALLS(HOOK_ID)
+#undef HOOK_ID
+  hook_count
+};
+
+const int category_count = (int)category::OTHER + 1;
+const char *category_names[category_count] = {
+    "draws", "uniform_lookups", "uniforms", "binds", "uploads", "others"};
+
+/**
+ * @brief Calls of a function, or of a category, in the current frame, in
+ * the worst frame and over every frame.
+ */
+struct Count {
+  unsigned long frame, worst, total;
+
+  void close() {
+    if (frame > worst) worst = frame;
+    total += frame;
+    frame = 0;
+  }
+};
+
+/**
+ * @brief A recorded function and its counts.
+ */
+struct Hooked {
+  const char *name;
+  category kind;
+  Count count;
+};
+
+Hooked hooks[hook_count] = {
+#define HOOK_ENTRY(function, kind) {#function, category::kind, {0, 0, 0}},
+    GL_CALLS(HOOK_ENTRY)
+#undef HOOK_ENTRY
+};
+Count categories[category_count], calls;
+unsigned long frames = 0;
+
+/**
+ * @brief Wrapper counting the calls to one function before forwarding them
+ * to the function glad loaded.
+ */
+template <int id, typename F>
+struct Hook;
+
+template <int id, typename R, typename... Args>
+struct Hook<id, R(APIENTRY *)(Args...)> {
+  static R(APIENTRY *original)(Args...);
+
+  static R APIENTRY record(Args... args) {
+    hooks[id].count.frame++;
+    return original(args...);
+  }
+};
+
+template <int id, typename R, typename... Args>
+R(APIENTRY *Hook<id, R(APIENTRY *)(Args...)>::original)(Args...) = nullptr;
+
+/**
+ * @brief Replace a function pointer loaded by glad with its wrapper.
+ *
+ * @param slot glad's pointer to the function
+ */
+template <int id, typename F>
+void hook(F &slot) {
+  Hook<id, F>::original = slot;
+  slot = &Hook<id, F>::record;
+}
+
+/**
+ * @brief Find the counts a budget refers to.
+ *
+ * @param name a GL function name, a category name or `calls`
+ *
+ * @return pointer to the counts, or null if the name is unknown
+ */
+const Count *find(const char *name) {
+  if (strcmp(name, "calls") == 0) return &calls;
+  for (int i = 0; i < category_count; i++)
+    if (strcmp(name, category_names[i]) == 0) return &categories[i];
+  for (const Hooked &hooked : hooks)
+    if (strcmp(name, hooked.name) == 0) return &hooked.count;
+  return NULL;
+}
+
+};  // namespace
+
+/**
+ * Functions glad couldn't load are left alone, so they fail as they would
+ * without recording.
+ */
+void install() {
+#define HOOK_INSTALL(function, kind) \
+  if (function != NULL) hook<function##_id>(function);
+  GL_CALLS(HOOK_INSTALL)
+#undef HOOK_INSTALL
+}
+
+void reset() {
+  for (Hooked &hooked : hooks) hooked.count = Count{0, 0, 0};
+  for (Count &count : categories) count = Count{0, 0, 0};
+  calls = Count{0, 0, 0};
+  frames = 0;
+}
+
+void endFrame() {
+  for (Hooked &hooked : hooks) {
+    categories[(int)hooked.kind].frame += hooked.count.frame;
+    calls.frame += hooked.count.frame;
+    hooked.count.close();
+  }
+  for (Count &count : categories) count.close();
+  calls.close();
+  frames++;
+}
+
+};  // namespace glrecord
+
+#endif
+
+namespace glrecord {
+
+bool check(const char *path) {
+#ifndef RECORD_GL
+  logger::log(logger::level::ERROR,
+              "GL call budgets need a build with RECORD_GL defined");
+  return false;
+#else
+  if (frames == 0) {
+    logger::log(logger::level::ERROR, "No frames were recorded for budgets");
+    return false;
+  }
+  FILE *file = fopen(path, "r");
+  if (file == NULL) {
+    logger::log(logger::level::ERROR, "Couldn't open %s", path);
+    return false;
+  }
+
+  logger::log(logger::level::INFO, "%-28s %12s %12s %12s", "budget", "worst",
+              "average", "max");
+  int exceeded = 0;
+  char line[256], name[128];
+  unsigned long budget;
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (line[0] == '#' || sscanf(line, "%127s %lu", name, &budget) != 2)
+      continue;
+    const Count *count = find(name);
+    if (count == NULL) {
+      logger::log(logger::level::ERROR, "%-28s %12s %12s %12lu unknown", name,
+                  "", "", budget);
+      exceeded++;
+    } else {
+      bool met = count->worst <= budget;
+      logger::log(met ? logger::level::INFO : logger::level::ERROR,
+                  "%-28s %12lu %12.1f %12lu %s", name, count->worst,
+                  (double)count->total / frames, budget,
+                  met ? "" : "exceeded");
+      if (!met) exceeded++;
+    }
+  }
+  fclose(file);
+
+  if (exceeded > 0)
+    logger::log(logger::level::ERROR,
+                "%d GL call budgets failed over %lu frames", exceeded, frames);
+  else
+    logger::log(logger::level::INFO, "GL call budgets met over %lu frames",
+                frames);
+  return exceeded == 0;
+#endif
+}
+
+};  // namespace glrecord
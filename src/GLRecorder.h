@@ -0,0 +1,75 @@
+/**
+ * @file GLRecorder.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the recording of OpenGL calls and the checking of per frame
+ * call budgets.
+ */
+#ifndef GL_RECORDER_H
+#define GL_RECORDER_H
+
+/**
+ * @brief Relates to recording every OpenGL call the game makes.
+ *
+ * When built with RECORD_GL defined, install() swaps the function pointers
+ * glad loaded for wrappers that count each call before forwarding it, so
+ * nothing in the game has to count its own calls. The counts are kept per
+ * frame, and the worst frame of a benchmark run can be checked against a
+ * budget file.
+ *
+ * Otherwise, recording compiles to nothing and budgets can't be checked.
+ */
+namespace glrecord {
+
+/**
+ * @brief Kinds of recorded calls, which budgets may cap as a whole.
+ */
+enum class category { DRAW, UNIFORM_LOOKUP, UNIFORM, BIND, UPLOAD, OTHER };
+
+#ifdef RECORD_GL
+
+/**
+ * @brief Start recording, once glad has loaded the OpenGL functions.
+ */
+void install();
+
+/**
+ * @brief Discard every count recorded so far.
+ */
+void reset();
+
+/**
+ * @brief Close the current frame, keeping its counts if they are the worst
+ * so far.
+ */
+void endFrame();
+
+#else
+
+inline void install() {}
+inline void reset() {}
+inline void endFrame() {}
+
+#endif
+
+/**
+ * @brief Check the recorded frames against a budget file, printing each
+ * budget's worst and average frame.
+ *
+ * Each line of the file holds a GL function name or a category, followed by
+ * the most calls allowed in any single frame. The categories are `draws`,
+ * `uniform_lookups`, `uniforms`, `binds`, `uploads`, `others` and `calls`,
+ * the latter counting every call. Lines starting with `#` are ignored.
+ *
+ * @param path the budget file's path
+ *
+ * @return true if every budget was met, otherwise false, including when
+ * nothing was recorded
+ */
+bool check(const char *path);
+
+};  // namespace glrecord
+
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @file GLStats.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Defines the counters of issued OpenGL calls.
+ */
+#ifndef GL_STATS_H
+#define GL_STATS_H
+
+/**
+ * @brief Relates to counting the OpenGL calls the game issues.
+ *
+ * Every draw call and uniform upload site bumps its counter right before the
+ * call, and every culled object counts whether or not it was drawn. The
+ * counters are plain integers, since every GL call is made from the thread
+ * owning the context.
+ */
+namespace glstats {
+
+/**
+ * @brief Amount of calls issued since the last reset.
+ */
+struct Counters {
+  unsigned long drawCalls = 0;
+  unsigned long uniformUploads = 0;
+  // instances that passed culling and were drawn, and those that didn't
+  unsigned long instancesDrawn = 0;
+  unsigned long instancesCulled = 0;
+};
+
+/**
+ * @brief Get the current counters.
+ *
+ * @return reference to the counters
+ */
+inline Counters &get() {
+  static Counters counters;
+  return counters;
+}
+
+/**
+ * @brief Count a draw call.
+ */
+inline void countDraw() { get().drawCalls++; }
+
+/**
+ * @brief Count a uniform upload.
+ */
+inline void countUniform() { get().uniformUploads++; }
+
+/**
+ * @brief Count an instance that went through culling.
+ *
+ * @param drawn whether the instance was drawn or culled
+ */
+inline void countInstance(bool drawn) {
+  if (drawn)
+    get().instancesDrawn++;
+  else
+    get().instancesCulled++;
+}
+
+/**
+ * @brief Count a batch of instances that went through culling together.
+ *
+ * @param drawn amount of instances drawn
+ * @param culled amount of instances culled
+ */
+inline void countInstances(unsigned long drawn, unsigned long culled) {
+  get().instancesDrawn += drawn;
+  get().instancesCulled += culled;
+}
+
+/**
+ * @brief Reset every counter to zero.
+ */
+inline void reset() { get() = Counters{}; }
+
+};  // namespace glstats
+
+#endif
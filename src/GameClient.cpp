@@ -0,0 +1,218 @@
+/**
+ * @file GameClient.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class following a game server's state.
+ */
+#include "GameClient.h"
+
+#include <algorithm>
+
+#include "GameRules.h"
+#include "Logger.h"
+#include "Tracer.h"
+#include "constants.h"
+
+using SELF = GameClient;
+
+GameClient::GameClient(uint16_t serverPort)
+    : server{net::loopback(serverPort)},
+      buffer(netConstants::max_packet),
+      synced{false},
+      round{0},
+      tick{0},
+      food{0, 0},
+      score{0},
+      direction{snake::movement::DOWN},
+      heard{std::chrono::steady_clock::now()},
+      sent{},
+      snapshots{0},
+      keyframes{0},
+      stale{0},
+      mismatches{0},
+      rounds{0},
+      bytes{0} {
+  latencies.reserve(netConstants::latency_samples);
+}
+
+bool GameClient::applyKeyframe(net::Reader &reader,
+                               const net::SnapshotHeader &header) {
+  net::Keyframe body;
+  if (!net::read(reader, body)) return false;
+  board = Board{body.width, body.height};
+  parts.clear();
+  parts.push_back(header.head);
+  unsigned int packed = 0;
+  for (uint32_t i = 1; i < header.length; i++) {
+    if ((i - 1) % 4 == 0) packed = (unsigned int)reader.get(1);
+    unsigned int step = packed >> (2 * ((i - 1) % 4)) & 3;
+    parts.push_back(net::step(parts.back(), (snake::movement)step, board));
+  }
+  if (!reader.ok()) return false;
+
+  if (header.round != round) rounds++;
+  round = header.round;
+  food = body.food;
+  score = body.score;
+  direction = body.direction;
+  keyframes++;
+  return true;
+}
+
+/**
+ * Deltas the state already went through are skipped, so that each snapshot
+ * can repeat those the server doesn't know were received.
+ */
+bool GameClient::applyDeltas(net::Reader &reader,
+                             const net::SnapshotHeader &header) {
+  uint32_t base = header.tick - header.deltas;
+  for (uint32_t t = base + 1; t <= header.tick; t++) {
+    net::Delta delta;
+    if (!net::read(reader, delta)) return false;
+    if (t <= tick) continue;
+    parts.push_front(net::step(parts.front(), delta.head, board));
+    parts.pop_back();
+    direction = delta.head;
+    if (delta.grew) {
+      parts.push_back(net::step(parts.back(), delta.tail, board));
+      score++;
+    }
+    if (delta.foodMoved) food = delta.food;
+  }
+  return true;
+}
+
+/**
+ * Snapshots no later than the state held, or whose Deltas start after it,
+ * are counted as stale and left out. A state failing the check against the
+ * snapshot's header is dropped, so that the next input asks for a keyframe.
+ */
+bool GameClient::apply(size_t size) {
+  net::Reader reader{buffer.data(), size};
+  net::SnapshotHeader header;
+  if (!net::read(reader, header)) return false;
+  snapshots++;
+  bytes += size;
+
+  // ticks keep counting over rounds, so no snapshot of a later tick is older
+  if (synced && header.tick <= tick) {
+    stale++;
+    return false;
+  }
+  bool applied;
+  if (header.keyframe)
+    applied = applyKeyframe(reader, header);
+  else if (!synced || header.round != round ||
+           header.tick - header.deltas > tick) {
+    stale++;
+    return false;
+  } else
+    applied = applyDeltas(reader, header);
+  tick = header.tick;
+
+  synced = applied && !parts.empty() && parts.front() == header.head &&
+           parts.size() == header.length;
+  if (!synced) {
+    mismatches++;
+    logger::log(logger::level::WARNING,
+                "State of tick %u failed its check, asking for a keyframe",
+                header.tick);
+    return false;
+  }
+
+  uint64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now().time_since_epoch())
+                     .count();
+  if (latencies.size() < latencies.capacity())
+    latencies.push_back((now - header.tickMicros) / 1000.0f);
+  return true;
+}
+
+bool GameClient::isOpen() const { return socket.isOpen(); }
+
+bool GameClient::isSynced() const { return synced; }
+
+uint32_t GameClient::currentTick() const { return tick; }
+
+const std::deque<glm::ivec2> &GameClient::getParts() const { return parts; }
+
+bool GameClient::receive(long timeoutMicros) {
+  net::Address from;
+  long got = socket.receive(buffer.data(), buffer.size(), from, timeoutMicros);
+  if (got < 0 || !(from == server)) return false;
+  heard = std::chrono::steady_clock::now();
+  tracer::Scope trace{"APPLY SNAPSHOT"};
+  apply(got);
+  return true;
+}
+
+SELF &GameClient::send(snake::movement steering) {
+  unsigned char packet[16];
+  net::Writer writer{packet, sizeof(packet)};
+  net::Input input;
+  input.round = round;
+  input.acknowledged = synced;
+  input.tick = tick;
+  input.direction = steering;
+  net::write(writer, input);
+  socket.send(server, packet, writer.length());
+  sent = std::chrono::steady_clock::now();
+  return *this;
+}
+
+snake::movement GameClient::steer() const {
+  if (!synced) return direction;
+  return autopilot(board.cell(parts.front().x, parts.front().y),
+                   board.cell(food.x, food.y), direction);
+}
+
+/**
+ * While nothing comes back, the latest input is resent every
+ * netConstants::rejoin_interval, which also joins the server in the first
+ * place.
+ */
+SELF &GameClient::run(const std::atomic<bool> &stop) {
+  using clock = std::chrono::steady_clock;
+  tracer::nameThread("client");
+  const std::chrono::duration<double> timeout{netConstants::timeout},
+      rejoin{netConstants::rejoin_interval};
+  const long wait =
+      std::chrono::duration_cast<std::chrono::microseconds>(rejoin).count();
+  send(direction);
+  while (!stop) {
+    if (receive(wait))
+      send(steer());
+    else if (clock::now() - sent > rejoin)
+      send(direction);
+    if (clock::now() - heard > timeout) break;
+  }
+  return *this;
+}
+
+void GameClient::reportHeader() {
+  logger::log(logger::level::INFO,
+              "%-10s %9s %9s %9s %6s %10s %6s %9s %9s %9s %9s", "client",
+              "snapshots", "B/tick", "keyframes", "stale", "mismatches",
+              "rounds", "avg ms", "p50 ms", "p99 ms", "max ms");
+}
+
+SELF &GameClient::report(const char *name) {
+  std::vector<float> sorted{latencies};
+  std::sort(sorted.begin(), sorted.end());
+  double sum = 0.0;
+  for (float latency : sorted) sum += latency;
+  auto percentile = [&sorted](double p) {
+    if (sorted.empty()) return 0.0f;
+    return sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))];
+  };
+  logger::log(logger::level::INFO,
+              "%-10s %9lu %9.1f %9lu %6lu %10lu %6lu %9.3f %9.3f %9.3f %9.3f",
+              name, snapshots,
+              snapshots > 0 ? (double)bytes / snapshots : 0.0, keyframes,
+              stale, mismatches, rounds,
+              sorted.empty() ? 0.0 : sum / sorted.size(), percentile(0.5),
+              percentile(0.99), sorted.empty() ? 0.0f : sorted.back());
+  return *this;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file GameClient.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class following a game server's state.
+ */
+#ifndef GAME_CLIENT_H
+#define GAME_CLIENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "Board.h"
+#include "Include/glm/glm.hpp"
+#include "Protocol.h"
+#include "SnakePart.h"
+#include "UdpSocket.h"
+
+/**
+ * @brief Rebuilds the state of a GameServer from its snapshots, and sends it
+ * inputs.
+ *
+ * Clients run headless, steering with the autopilot, and measure the bytes
+ * each snapshot takes and the latency from the server's tick to the client
+ * holding it.
+ *
+ * @see net
+ */
+class GameClient {
+  using SELF = GameClient;
+
+  net::UdpSocket socket;
+  net::Address server;
+  // holds each packet received
+  std::vector<unsigned char> buffer;
+
+  // the state as of tick, with the Snake's cells from its head
+  bool synced;
+  uint16_t round;
+  uint32_t tick;
+  Board board;
+  std::deque<glm::ivec2> parts;
+  glm::ivec2 food;
+  unsigned long score;
+  snake::movement direction;
+  std::chrono::steady_clock::time_point heard, sent;
+
+  unsigned long snapshots, keyframes, stale, mismatches, rounds;
+  unsigned long long bytes;
+  // from each tick being stepped to the client holding it, in milliseconds
+  std::vector<float> latencies;
+
+  /**
+   * @brief Apply a snapshot received into the buffer.
+   *
+   * @param size amount of bytes received
+   *
+   * @return whether or not the snapshot brought the state to a later tick
+   */
+  bool apply(size_t size);
+  /**
+   * @brief Replace the state with a keyframe's.
+   *
+   * @param reader the snapshot's Reader, past its header
+   * @param header the snapshot's header
+   *
+   * @return whether or not the keyframe was whole
+   */
+  bool applyKeyframe(net::Reader &reader, const net::SnapshotHeader &header);
+  /**
+   * @brief Bring the state up to a snapshot's tick with its Deltas.
+   *
+   * @param reader the snapshot's Reader, past its header
+   * @param header the snapshot's header
+   *
+   * @return whether or not the Deltas were whole
+   */
+  bool applyDeltas(net::Reader &reader, const net::SnapshotHeader &header);
+
+ public:
+  /**
+   * @brief Constructor for a client of a server on the loopback interface.
+   *
+   * @param serverPort the port the server listens on
+   */
+  explicit GameClient(uint16_t serverPort);
+
+  /**
+   * @brief Check whether or not the client's socket is open.
+   *
+   * @return true if open, otherwise false
+   */
+  bool isOpen() const;
+  /**
+   * @brief Check whether or not the client holds the server's state.
+   *
+   * @return true if it holds a state that passed its check, otherwise false
+   */
+  bool isSynced() const;
+  /**
+   * @brief Get the tick of the state held.
+   *
+   * @return the tick
+   */
+  uint32_t currentTick() const;
+  /**
+   * @brief Get the cells of the Snake held.
+   *
+   * @return the cells, from the head
+   */
+  const std::deque<glm::ivec2> &getParts() const;
+
+  /**
+   * @brief Wait for a snapshot and apply it.
+   *
+   * @param timeoutMicros longest wait, in microseconds
+   *
+   * @return whether or not a snapshot was received
+   */
+  bool receive(long timeoutMicros);
+  /**
+   * @brief Send an input, acknowledging the state held.
+   *
+   * @param steering the direction steered towards
+   *
+   * @return reference to the object
+   */
+  SELF &send(snake::movement steering);
+  /**
+   * @brief Choose a direction towards the food with the autopilot.
+   *
+   * @return the direction
+   */
+  snake::movement steer() const;
+  /**
+   * @brief Follow the server, answering every snapshot with an input, until
+   * stopped or the server goes silent for netConstants::timeout.
+   *
+   * @param stop set once the client should stop
+   *
+   * @return reference to the object
+   */
+  SELF &run(const std::atomic<bool> &stop);
+  /**
+   * @brief Log a line of the client's measurements, under the header logged
+   * by GameClient::reportHeader.
+   *
+   * @param name the client's name in the report
+   *
+   * @return reference to the object
+   */
+  SELF &report(const char *name);
+  /**
+   * @brief Log the header of the clients' measurements.
+   */
+  static void reportHeader();
+};
+
+#endif
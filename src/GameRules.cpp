@@ -0,0 +1,93 @@
+/**
+ * @file GameRules.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the rules shared by the game and its server.
+ */
+#include "GameRules.h"
+
+#include <ctime>
+#include <vector>
+
+#include "AllocationTracker.h"
+#include "constants.h"
+
+std::mt19937 rng(time(NULL));
+
+/**
+ * New positions are drawn uniformly over the cells of the board until one
+ * outside of the Snake is found, so the cost depends on the Snake's length
+ * and not on the board's area. Once the Snake covers most of the board,
+ * draws rarely land on a free cell, so after
+ * boardConstants::relocation_attempts of them the free cells are searched
+ * instead, starting from a random one.
+ */
+bool relocatePoint(const snake::Snake &snek, Point &point, const Board &board) {
+  if (!snek.pointCollisionAll(point.getTrans())) return true;
+  std::uniform_int_distribution<int> column(0, board.getWidth() - 1);
+  std::uniform_int_distribution<int> row(0, board.getHeight() - 1);
+  for (int i = 0; i < boardConstants::relocation_attempts; i++) {
+    int x = column(rng);
+    point = Point{board.cell(x, row(rng)), modelConstants::scale_factor};
+    if (!snek.pointCollisionAll(point.getTrans())) return true;
+  }
+
+  // only reached near the end of a game, so the allocation is accepted
+  allocation::Exempt exempt;
+  const long width = board.getWidth(), area = board.area();
+  std::vector<bool> taken(area);
+  for (const snake::SnakePart &part : snek.getParts()) {
+    glm::ivec2 cell = board.cellOf(part.getTrans());
+    taken[cell.y * width + cell.x] = true;
+  }
+  long start = std::uniform_int_distribution<long>(0, area - 1)(rng);
+  for (long i = 0; i < area; i++) {
+    long free = (start + i) % area;
+    if (taken[free]) continue;
+    point = Point{board.cell(free % width, free / width),
+                  modelConstants::scale_factor};
+    return true;
+  }
+  return false;
+}
+
+snake::movement autopilot(const snake::Snake &snek, const glm::vec3 &target,
+                          snake::movement current) {
+  return autopilot(snek.getHeadTrans(), target, current);
+}
+
+/**
+ * The Snake is steered along the x axis first, then along the z axis, without
+ * accounting for the plane wrapping around. When the way to the target is
+ * straight behind the head, it turns aside instead.
+ */
+snake::movement autopilot(const glm::vec3 &head, const glm::vec3 &target,
+                          snake::movement current) {
+  float dx = target.x - head.x, dz = target.z - head.z;
+  const float e = 0.001f;
+
+  snake::movement wanted = current;
+  if (dx > e)
+    wanted = snake::movement::DOWN;
+  else if (dx < -e)
+    wanted = snake::movement::UP;
+  else if (dz > e)
+    wanted = snake::movement::LEFT;
+  else if (dz < -e)
+    wanted = snake::movement::RIGHT;
+
+  bool reverse = (wanted == snake::movement::DOWN &&
+                  current == snake::movement::UP) ||
+                 (wanted == snake::movement::UP &&
+                  current == snake::movement::DOWN) ||
+                 (wanted == snake::movement::LEFT &&
+                  current == snake::movement::RIGHT) ||
+                 (wanted == snake::movement::RIGHT &&
+                  current == snake::movement::LEFT);
+  if (!reverse) return wanted;
+  if (current == snake::movement::UP || current == snake::movement::DOWN)
+    return dz < 0 ? snake::movement::RIGHT : snake::movement::LEFT;
+  return dx < 0 ? snake::movement::UP : snake::movement::DOWN;
+}
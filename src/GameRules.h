@@ -0,0 +1,58 @@
+/**
+ * @file GameRules.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the rules shared by the game and its server.
+ */
+#ifndef GAME_RULES_H
+#define GAME_RULES_H
+
+#include <random>
+
+#include "Board.h"
+#include "Include/glm/glm.hpp"
+#include "Point.h"
+#include "Snake.h"
+
+// draws the Point's cells, seeded with the time unless a benchmark reseeds it
+extern std::mt19937 rng;
+
+/**
+ * @brief Move a Point to a random cell of the board, if it is within the
+ * Snake.
+ *
+ * @param snek game Snake
+ * @param point game Point
+ * @param board the board the game is played on
+ *
+ * @return false if the Snake covers the whole board, leaving the Point where
+ * it was, otherwise true
+ */
+bool relocatePoint(const snake::Snake &snek, Point &point, const Board &board);
+
+/**
+ * @brief Choose a direction that steers the Snake towards a target.
+ *
+ * @param snek game Snake
+ * @param target position to steer towards
+ * @param current the direction in effect
+ *
+ * @return the new direction, never the opposite of current
+ */
+snake::movement autopilot(const snake::Snake &snek, const glm::vec3 &target,
+                          snake::movement current);
+/**
+ * @brief Choose a direction that steers a Snake's head towards a target.
+ *
+ * @param head position of the Snake's head
+ * @param target position to steer towards
+ * @param current the direction in effect
+ *
+ * @return the new direction, never the opposite of current
+ */
+snake::movement autopilot(const glm::vec3 &head, const glm::vec3 &target,
+                          snake::movement current);
+
+#endif
@@ -0,0 +1,283 @@
+/**
+ * @file GameServer.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class for the authoritative game server.
+ */
+#include "GameServer.h"
+
+#include <algorithm>
+
+#include "GameRules.h"
+#include "Logger.h"
+#include "Tracer.h"
+#include "constants.h"
+
+using SELF = GameServer;
+
+namespace {
+
+/**
+ * @brief Get a steady clock time in microseconds, as sent in snapshots.
+ */
+uint64_t micros(std::chrono::steady_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+};  // namespace
+
+GameServer::GameServer(uint16_t port, const Board &_board, int _startLength,
+                       double _lossRate)
+    : socket{port},
+      board{_board},
+      startLength{std::min(std::max(_startLength, 1), _board.maxStartLength())},
+      round{0},
+      tick{0},
+      direction{snake::movement::DOWN},
+      history(netConstants::history_ticks),
+      buffer(netConstants::max_packet),
+      lossRate{_lossRate},
+      lossRng{benchConstants::seed},
+      ticks{0},
+      snapshots{0},
+      keyframes{0},
+      dropped{0},
+      bytes{0},
+      keyframeBytes{0},
+      fullBytes{0},
+      stepMicros{0.0},
+      sendMicros{0.0} {
+  clients.reserve(netConstants::max_clients);
+  startRound();
+}
+
+void GameServer::startRound() {
+  simulation.reset();
+  snek.reset(new snake::Snake{board.center(), startLength,
+                              modelConstants::scale_factor,
+                              modelConstants::scale_factor, board.borderX(),
+                              board.borderZ(), snake::movement::DOWN,
+                              board.reservedParts(startLength)});
+  point.reset(new Point{board.center(), modelConstants::scale_factor});
+  relocatePoint(*snek, *point, board);
+  score.reset(new Score);
+  simulation.reset(new Simulation{*snek, *point, *score, board, nullptr,
+                                  nullptr, board.reservedParts(startLength)});
+  direction = snake::movement::DOWN;
+  round++;
+}
+
+/**
+ * Acknowledgements may arrive out of order, so only the latest one of the
+ * current round is kept. An input acknowledging nothing asks for a keyframe.
+ */
+void GameServer::handle(size_t size, const net::Address &from) {
+  net::Reader reader{buffer.data(), size};
+  net::Input input;
+  if (!net::read(reader, input)) return;
+
+  Client *client = NULL;
+  for (Client &known : clients)
+    if (known.address == from) client = &known;
+  if (client == NULL) {
+    if ((int)clients.size() == netConstants::max_clients) return;
+    clients.push_back(Client{from, false, 0, 0, {}});
+    client = &clients.back();
+    logger::log(logger::level::INFO, "Client joined from port %u, %zu playing",
+                (unsigned)from.port, clients.size());
+  }
+  client->heard = std::chrono::steady_clock::now();
+
+  if (!input.acknowledged)
+    client->acknowledged = false;
+  else if (input.round == round && input.tick <= tick &&
+           (!client->acknowledged || client->round != round ||
+            input.tick > client->tick)) {
+    client->acknowledged = true;
+    client->round = input.round;
+    client->tick = input.tick;
+  }
+  if (client == &clients.front()) direction = input.direction;
+}
+
+bool GameServer::step() {
+  glm::ivec2 head = board.cellOf(snek->getHeadTrans());
+  glm::ivec2 food = board.cellOf(point->getTrans());
+  size_t length = snek->getLength();
+
+  bool collided = simulation->step(direction);
+  tick++;
+
+  net::Delta &delta = history[tick % history.size()];
+  net::direction(head, board.cellOf(snek->getHeadTrans()), board, delta.head);
+  delta.grew = snek->getLength() > length;
+  delta.tail = snake::movement::RIGHT;
+  if (delta.grew) {
+    const std::vector<snake::SnakePart> &parts = snek->getParts();
+    net::direction(board.cellOf(parts[parts.size() - 2].getTrans()),
+                   board.cellOf(parts.back().getTrans()), board, delta.tail);
+  }
+  delta.food = board.cellOf(point->getTrans());
+  delta.foodMoved = delta.food != food;
+  return collided;
+}
+
+/**
+ * A keyframe is written when the client holds nothing of the current round,
+ * or when the Deltas it lacks are no longer kept.
+ */
+size_t GameServer::writeSnapshot(const Client &client, uint64_t tickMicros,
+                                 bool &keyframe) {
+  keyframe = !client.acknowledged || client.round != round ||
+             tick - client.tick > history.size();
+
+  net::Writer writer{buffer.data(), buffer.size()};
+  net::SnapshotHeader header;
+  header.round = round;
+  header.keyframe = keyframe;
+  header.deltas = keyframe ? 0 : (uint8_t)(tick - client.tick);
+  header.tick = tick;
+  header.tickMicros = tickMicros;
+  header.head = board.cellOf(snek->getHeadTrans());
+  header.length = (uint32_t)snek->getLength();
+  net::write(writer, header);
+
+  if (!keyframe) {
+    for (uint32_t t = client.tick + 1; t <= tick; t++)
+      net::write(writer, history[t % history.size()]);
+    return writer.ok() ? writer.length() : 0;
+  }
+
+  const std::vector<snake::SnakePart> &parts = snek->getParts();
+  net::Keyframe body;
+  body.width = (uint16_t)board.getWidth();
+  body.height = (uint16_t)board.getHeight();
+  body.score = (uint32_t)score->getScore();
+  body.direction = parts[0].getDirection();
+  body.food = board.cellOf(point->getTrans());
+  net::write(writer, body);
+  glm::ivec2 previous = header.head;
+  unsigned int packed = 0;
+  for (size_t i = 1; i < parts.size(); i++) {
+    glm::ivec2 cell = board.cellOf(parts[i].getTrans());
+    snake::movement step = snake::movement::RIGHT;
+    net::direction(previous, cell, board, step);
+    packed |= (unsigned int)step << (2 * ((i - 1) % 4));
+    if (i % 4 == 0 || i + 1 == parts.size()) {
+      writer.put(packed, 1);
+      packed = 0;
+    }
+    previous = cell;
+  }
+  return writer.ok() ? writer.length() : 0;
+}
+
+void GameServer::broadcast(uint64_t tickMicros) {
+  std::uniform_real_distribution<double> loss(0.0, 1.0);
+  for (const Client &client : clients) {
+    bool keyframe;
+    size_t size = writeSnapshot(client, tickMicros, keyframe);
+    if (size == 0) {
+      logger::log(logger::level::WARNING,
+                  "Snapshot of tick %u doesn't fit in a datagram", tick);
+      continue;
+    }
+    snapshots++;
+    bytes += size;
+    fullBytes += net::snapshot_header_size + net::keyframe_size +
+                 4 * snek->getLength();
+    if (keyframe) {
+      keyframes++;
+      keyframeBytes += size;
+    }
+    if (lossRate > 0.0 && loss(lossRng) < lossRate) {
+      dropped++;
+      continue;
+    }
+    socket.send(client.address, buffer.data(), size);
+  }
+}
+
+bool GameServer::isOpen() const { return socket.isOpen(); }
+
+uint16_t GameServer::port() const { return socket.port(); }
+
+uint32_t GameServer::currentTick() const { return tick; }
+
+const snake::Snake &GameServer::getSnake() const { return *snek; }
+
+/**
+ * Inputs are handled as they come in until the next tick is due, so the wait
+ * between ticks is spent blocked on the socket. Clients silent for longer
+ * than netConstants::timeout are dropped.
+ */
+SELF &GameServer::run(double rate, unsigned long count) {
+  using clock = std::chrono::steady_clock;
+  tracer::nameThread("server");
+  const clock::duration interval = std::chrono::duration_cast<clock::duration>(
+      std::chrono::duration<double>(1.0 / std::max(rate, 0.1)));
+  const std::chrono::duration<double> timeout{netConstants::timeout};
+  clock::time_point next = clock::now() + interval;
+
+  for (unsigned long i = 0; count == 0 || i < count; i++) {
+    for (;;) {
+      long wait = std::chrono::duration_cast<std::chrono::microseconds>(
+                      next - clock::now())
+                      .count();
+      net::Address from;
+      long got = socket.receive(buffer.data(), buffer.size(), from,
+                                std::max(wait, 0L));
+      if (got >= 0)
+        handle(got, from);
+      else if (wait <= 0)
+        break;
+    }
+
+    clock::time_point now = clock::now();
+    for (size_t c = clients.size(); c-- > 0;)
+      if (now - clients[c].heard > timeout) {
+        logger::log(logger::level::INFO, "Client from port %u timed out",
+                    (unsigned)clients[c].address.port);
+        clients.erase(clients.begin() + c);
+      }
+
+    next += interval;
+    clock::duration behind = now - next;
+    if (behind > interval * tickConstants::max_catch_up)
+      next += interval * (behind / interval);
+
+    tracer::Scope trace{"SERVER TICK"};
+    if (step()) startRound();
+    ticks++;
+    clock::time_point stepped = clock::now();
+    broadcast(micros(stepped));
+    clock::time_point sent = clock::now();
+    stepMicros +=
+        std::chrono::duration<double, std::micro>(stepped - now).count();
+    sendMicros +=
+        std::chrono::duration<double, std::micro>(sent - stepped).count();
+  }
+  return *this;
+}
+
+SELF &GameServer::report() {
+  double perTick = ticks > 0 ? 1.0 / ticks : 0.0;
+  double perSnapshot = snapshots > 0 ? 1.0 / snapshots : 0.0;
+  logger::log(logger::level::INFO,
+              "Server ran %lu ticks over %u rounds, sending %lu snapshots, "
+              "%lu of them keyframes, %lu dropped",
+              ticks, (unsigned)round, snapshots, keyframes, dropped);
+  logger::log(logger::level::INFO,
+              "Server tick: %.1f us stepping, %.1f us sending",
+              stepMicros * perTick, sendMicros * perTick);
+  logger::log(logger::level::INFO,
+              "Server bandwidth: %.1f B per client per tick, %.1f B of it in "
+              "keyframes, where full part lists would take %.1f B",
+              bytes * perSnapshot, keyframeBytes * perSnapshot,
+              fullBytes * perSnapshot);
+  return *this;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file GameServer.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class for the authoritative game server.
+ */
+#ifndef GAME_SERVER_H
+#define GAME_SERVER_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Board.h"
+#include "Point.h"
+#include "Protocol.h"
+#include "Score.h"
+#include "Simulation.h"
+#include "Snake.h"
+#include "UdpSocket.h"
+
+/**
+ * @brief Steps the game at a fixed tick, sending its state to every client
+ * over UDP.
+ *
+ * The Snake, Point and Score are ticked by a Simulation, as in the game,
+ * steered by the client that joined first while the others watch. When the
+ * Snake runs into itself or fills the board, a new round starts.
+ *
+ * @see net
+ */
+class GameServer {
+  using SELF = GameServer;
+
+  /**
+   * @brief A client, known by the address its inputs come from.
+   */
+  struct Client {
+    net::Address address;
+    // the latest snapshot the client holds, if any
+    bool acknowledged;
+    uint16_t round;
+    uint32_t tick;
+    std::chrono::steady_clock::time_point heard;
+  };
+
+  net::UdpSocket socket;
+  Board board;
+  int startLength;
+  std::unique_ptr<snake::Snake> snek;
+  std::unique_ptr<Point> point;
+  std::unique_ptr<Score> score;
+  std::unique_ptr<Simulation> simulation;
+  uint16_t round;
+  uint32_t tick;
+  snake::movement direction;
+  // Deltas of the latest ticks, indexed by tick modulo their amount
+  std::vector<net::Delta> history;
+  std::vector<Client> clients;
+  // holds each packet sent or received
+  std::vector<unsigned char> buffer;
+  double lossRate;
+  std::mt19937 lossRng;
+
+  unsigned long ticks, snapshots, keyframes, dropped;
+  unsigned long long bytes, keyframeBytes, fullBytes;
+  double stepMicros, sendMicros;
+
+  /**
+   * @brief Start a round, with a new Snake, Point and Score.
+   */
+  void startRound();
+  /**
+   * @brief Handle a packet from a client, letting it join if it is new.
+   *
+   * @param size amount of bytes received into the buffer
+   * @param from the address the packet came from
+   */
+  void handle(size_t size, const net::Address &from);
+  /**
+   * @brief Step the Simulation once, and record what changed.
+   *
+   * @return whether or not the round ended
+   */
+  bool step();
+  /**
+   * @brief Write the snapshot bringing a client to the current tick into
+   * the buffer.
+   *
+   * @param client the client
+   * @param tickMicros time the tick was stepped at, in microseconds
+   * @param keyframe set to whether or not the snapshot is a keyframe
+   *
+   * @return size of the snapshot, or 0 if it couldn't fit in a datagram
+   */
+  size_t writeSnapshot(const Client &client, uint64_t tickMicros,
+                       bool &keyframe);
+  /**
+   * @brief Send every client its snapshot of the current tick.
+   *
+   * @param tickMicros time the tick was stepped at, in microseconds
+   */
+  void broadcast(uint64_t tickMicros);
+
+ public:
+  /**
+   * @brief Constructor for a server, with its first round started.
+   *
+   * @param port the loopback port listened on, or 0 to have one picked
+   * @param _board the board the game is played on
+   * @param _startLength amount of parts the Snake starts each round with, at
+   * most Board::maxStartLength
+   * @param _lossRate share of the snapshots dropped instead of sent, from 0.0
+   * to 1.0, to exercise how clients recover
+   */
+  GameServer(uint16_t port, const Board &_board, int _startLength,
+             double _lossRate = 0.0);
+
+  /**
+   * @brief Check whether or not the server's socket is open.
+   *
+   * @return true if open, otherwise false
+   */
+  bool isOpen() const;
+  /**
+   * @brief Get the port the server listens on.
+   *
+   * @return the port
+   */
+  uint16_t port() const;
+  /**
+   * @brief Get the current tick.
+   *
+   * @return the amount of ticks stepped, over every round
+   */
+  uint32_t currentTick() const;
+  /**
+   * @brief Get the Snake of the current round.
+   *
+   * @return reference to the Snake
+   */
+  const snake::Snake &getSnake() const;
+
+  /**
+   * @brief Step the game at a fixed rate, handling inputs between ticks.
+   *
+   * @param rate ticks per second
+   * @param count amount of ticks run, or 0 to run forever
+   *
+   * Late ticks are run back to back to catch up, unless the server fell more
+   * than tickConstants::max_catch_up periods behind.
+   *
+   * @return reference to the object
+   */
+  SELF &run(double rate, unsigned long count);
+  /**
+   * @brief Log the ticks run and the bandwidth used per tick.
+   *
+   * @return reference to the object
+   */
+  SELF &report();
+};
+
+#endif
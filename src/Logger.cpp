@@ -0,0 +1,308 @@
+/**
+ * @file Logger.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the asynchronous logging functions.
+ */
+#include "Logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "constants.h"
+
+namespace logger {
+
+namespace {
+
+static_assert((logConstants::capacity & (logConstants::capacity - 1)) == 0,
+              "logger capacity must be a power of two");
+static_assert((logConstants::rate_limit_slots &
+               (logConstants::rate_limit_slots - 1)) == 0,
+              "logger rate limit slots must be a power of two");
+
+/**
+ * @brief A single message cell of the ring buffer.
+ *
+ * The sequence number tells producers and the consumer whose turn it is to
+ * touch the cell, as in a bounded multi-producer queue.
+ */
+struct Slot {
+  std::atomic<size_t> sequence;
+  level lvl;
+  char text[logConstants::message_size];
+};
+
+/**
+ * @brief Rate-limiting state for the messages sharing a text.
+ *
+ * The text is kept so that repetitions still pending when the entry is taken
+ * over, or when the logger stops, can be reported. The entry is guarded by a
+ * spin lock, only ever held for a few comparisons and copies.
+ */
+struct RateEntry {
+  std::atomic_flag busy = ATOMIC_FLAG_INIT;
+  uint64_t hash = 0;
+  long long last = 0;
+  unsigned long suppressed = 0;
+  level lvl = level::INFO;
+  char text[logConstants::message_size] = "";
+
+  void lock() {
+    while (busy.test_and_set(std::memory_order_acquire)) continue;
+  }
+  void unlock() { busy.clear(std::memory_order_release); }
+};
+
+/**
+ * @brief The logger's shared state.
+ */
+struct Ring {
+  Slot slots[logConstants::capacity];
+  RateEntry rates[logConstants::rate_limit_slots];
+  std::atomic<size_t> enqueuePos{0};
+  size_t dequeuePos = 0;  // owned by the single consumer
+  std::atomic<unsigned long> dropped{0};
+  std::atomic<int> minLevel{(int)level::INFO};
+  std::atomic<bool> running{false};
+  std::thread worker;
+
+  Ring() {
+    for (size_t i = 0; i < logConstants::capacity; i++)
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+};
+
+Ring &ring() {
+  static Ring r;
+  return r;
+}
+
+const char *levelName(level lvl) {
+  switch (lvl) {
+    case level::DEBUG:
+      return "DEBUG";
+    case level::INFO:
+      return "INFO";
+    case level::WARNING:
+      return "WARNING";
+    case level::ERROR:
+      return "ERROR";
+    default:
+      return "";  // will never run
+  }
+}
+
+long long nowNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * @brief Hash a message's text, with 64-bit FNV-1a.
+ *
+ * @param text the formatted message
+ *
+ * @return the hash
+ */
+uint64_t hashText(const char *text) {
+  uint64_t hash = 14695981039346656037ull;
+  for (; *text != '\0'; text++)
+    hash = (hash ^ (unsigned char)*text) * 1099511628211ull;
+  return hash;
+}
+
+/**
+ * @brief Append the amount of suppressed repetitions to a message.
+ *
+ * @param text the formatted message, message_size bytes long
+ * @param suppressed the amount of repetitions, nothing is appended if 0
+ */
+void appendSuppressed(char *text, unsigned long suppressed) {
+  if (suppressed == 0) return;
+  size_t len = strlen(text);
+  snprintf(text + len, logConstants::message_size - len,
+           " (%lu repetitions suppressed)", suppressed);
+}
+
+/**
+ * @brief Claim a cell of the ring buffer and copy a message into it.
+ *
+ * @param lvl the severity of the message
+ * @param text the formatted message
+ *
+ * If the ring buffer is full the message is dropped and counted.
+ */
+void enqueue(level lvl, const char *text) {
+  Ring &r = ring();
+  size_t pos = r.enqueuePos.load(std::memory_order_relaxed);
+  Slot *slot;
+  for (;;) {
+    slot = &r.slots[pos & (logConstants::capacity - 1)];
+    size_t seq = slot->sequence.load(std::memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+    if (diff == 0) {
+      if (r.enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed))
+        break;
+    } else if (diff < 0) {
+      r.dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else
+      pos = r.enqueuePos.load(std::memory_order_relaxed);
+  }
+
+  slot->lvl = lvl;
+  snprintf(slot->text, sizeof(slot->text), "%s", text);
+  slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Decides whether a message should be suppressed.
+ *
+ * @param lvl the severity of the message
+ * @param text the formatted message, used as its identity
+ * @param suppressed filled with the amount of repetitions suppressed since the
+ * last time the message went through
+ *
+ * @return true if the message must be suppressed, otherwise false
+ *
+ * Messages whose texts share a slot take it over from each other, which at
+ * worst lets an extra message through. Repetitions still pending on the
+ * message taken over are logged along with its text.
+ */
+bool throttle(level lvl, const char *text, unsigned long &suppressed) {
+  const long long interval =
+      (long long)(logConstants::rate_limit_interval * 1e9);
+  uint64_t hash = hashText(text);
+  RateEntry &entry =
+      ring().rates[hash & (logConstants::rate_limit_slots - 1)];
+  long long now = nowNanoseconds();
+  suppressed = 0;
+
+  entry.lock();
+  if (entry.hash != hash || strcmp(entry.text, text) != 0) {
+    char pending[logConstants::message_size];
+    level pendingLvl = entry.lvl;
+    unsigned long pendingCount = entry.suppressed;
+    if (pendingCount > 0) memcpy(pending, entry.text, sizeof(pending));
+    entry.hash = hash;
+    entry.last = now;
+    entry.suppressed = 0;
+    entry.lvl = lvl;
+    snprintf(entry.text, sizeof(entry.text), "%s", text);
+    entry.unlock();
+    if (pendingCount > 0) {
+      appendSuppressed(pending, pendingCount);
+      enqueue(pendingLvl, pending);
+    }
+    return false;
+  }
+
+  bool throttled = now - entry.last < interval;
+  if (throttled) {
+    entry.suppressed++;
+  } else {
+    suppressed = entry.suppressed;
+    entry.suppressed = 0;
+    entry.last = now;
+  }
+  entry.unlock();
+  return throttled;
+}
+
+/**
+ * @brief Writes every message currently queued to stderr.
+ *
+ * @return whether or not any message was written
+ *
+ * Must only be called by one thread at a time.
+ */
+bool flush() {
+  Ring &r = ring();
+  bool wrote = false;
+  for (;;) {
+    Slot &slot = r.slots[r.dequeuePos & (logConstants::capacity - 1)];
+    size_t seq = slot.sequence.load(std::memory_order_acquire);
+    if ((intptr_t)seq - (intptr_t)(r.dequeuePos + 1) < 0) break;
+
+    fprintf(stderr, "[%s] %s\n", levelName(slot.lvl), slot.text);
+    slot.sequence.store(r.dequeuePos + logConstants::capacity,
+                        std::memory_order_release);
+    r.dequeuePos++;
+    wrote = true;
+  }
+  if (wrote) fflush(stderr);
+  return wrote;
+}
+
+void drain() {
+  while (ring().running.load(std::memory_order_acquire))
+    if (!flush())
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(logConstants::drain_interval_ms));
+}
+
+};  // namespace
+
+void start(level minLevel) {
+  Ring &r = ring();
+  r.minLevel.store((int)minLevel, std::memory_order_relaxed);
+  if (!r.running.exchange(true)) r.worker = std::thread(drain);
+}
+
+/**
+ * The remaining messages are written from the calling thread once the
+ * background thread is joined, followed by the repetitions still suppressed
+ * and a count of dropped messages, if any.
+ */
+void stop() {
+  Ring &r = ring();
+  if (r.running.exchange(false)) r.worker.join();
+  flush();
+  for (RateEntry &entry : r.rates) {
+    entry.lock();
+    if (entry.suppressed > 0)
+      fprintf(stderr, "[%s] %s (%lu repetitions suppressed)\n",
+              levelName(entry.lvl), entry.text, entry.suppressed);
+    entry.suppressed = 0;
+    entry.unlock();
+  }
+  unsigned long lost = r.dropped.exchange(0);
+  if (lost > 0) fprintf(stderr, "[WARNING] %lu log messages dropped\n", lost);
+}
+
+/**
+ * The message is formatted on the stack and copied into a claimed cell of the
+ * ring buffer, so no allocation or lock on the buffer takes place. Errors are
+ * never rate-limited.
+ */
+void log(level lvl, const char *fmt, ...) {
+  Ring &r = ring();
+  if ((int)lvl < r.minLevel.load(std::memory_order_relaxed)) return;
+
+  char text[logConstants::message_size];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(text, sizeof(text), fmt, args);
+  va_end(args);
+
+  unsigned long suppressed = 0;
+  if (lvl != level::ERROR && throttle(lvl, text, suppressed)) return;
+  appendSuppressed(text, suppressed);
+  enqueue(lvl, text);
+}
+
+unsigned long dropped() {
+  return ring().dropped.load(std::memory_order_relaxed);
+}
+
+};  // namespace logger
@@ -0,0 +1,67 @@
+/**
+ * @file Logger.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the asynchronous logging functions.
+ */
+#ifndef LOGGER_H
+#define LOGGER_H
+
+/**
+ * @brief Relates to the logging subsystem.
+ *
+ * Messages are formatted by the caller into a lock-free ring buffer and
+ * written to stderr by a background thread, so that logging never blocks the
+ * render or audio threads on stdio.
+ */
+namespace logger {
+
+/**
+ * @brief Represents the severity of a logged message.
+ */
+enum class level { DEBUG, INFO, WARNING, ERROR };
+
+/**
+ * @brief Starts the background thread that writes queued messages out.
+ *
+ * @param minLevel messages below this level are discarded on the spot
+ *
+ * Calling it while the logger is already running only updates minLevel.
+ */
+void start(level minLevel = level::INFO);
+
+/**
+ * @brief Writes every queued message out and stops the background thread.
+ */
+void stop();
+
+/**
+ * @brief Queues a printf-style message to be logged.
+ *
+ * @param lvl the severity of the message
+ * @param fmt printf-style format string, without a trailing new line
+ *
+ * Safe to call from any thread. Messages other than errors are rate-limited
+ * by their formatted text, so a message repeated every frame is written at
+ * most once per logConstants::rate_limit_interval, followed by a count of the
+ * suppressed repetitions. If the ring buffer is full the message is dropped
+ * and counted.
+ */
+void log(level lvl, const char *fmt, ...)
+#ifdef __GNUC__
+    __attribute__((format(printf, 2, 3)))
+#endif
+    ;
+
+/**
+ * @brief Get the amount of messages dropped because the buffer was full.
+ *
+ * @return the amount of dropped messages
+ */
+unsigned long dropped();
+
+};  // namespace logger
+
+#endif
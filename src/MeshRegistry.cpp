@@ -0,0 +1,162 @@
+/**
+ * @file MeshRegistry.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the registry packing every static mesh into shared
+ * buffers.
+ */
+#include "MeshRegistry.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "GLStats.h"
+#include "Include/glm/gtc/type_ptr.hpp"
+#include "Logger.h"
+#include "Tracer.h"
+
+using SELF = MeshRegistry;
+
+void Mesh::bind() const { glBindVertexArray(VAO); }
+
+void Mesh::draw() const {
+  glDrawElementsBaseVertex(GL_TRIANGLES, count, indexType,
+                           (void *)indexOffset, baseVertex);
+}
+
+void Mesh::draw(const glm::mat4 &model, GLint location) const {
+  glstats::countUniform();
+  glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(model));
+  glstats::countDraw();
+  draw();
+}
+
+void Mesh::drawInstanced(GLsizei instances) const {
+  glDrawElementsInstancedBaseVertex(GL_TRIANGLES, count, indexType,
+                                    (void *)indexOffset, instances,
+                                    baseVertex);
+}
+
+MeshRegistry::MeshRegistry() : meshes{0} {
+  glGenBuffers(1, &VBO);
+  glGenBuffers(1, &EBO);
+}
+
+size_t MeshRegistry::store(const void *data, size_t size, GLuint kind,
+                           size_t alignment,
+                           std::vector<unsigned char> &buffer,
+                           std::vector<Run> &runs) {
+  for (const Run &run : runs)
+    if (run.kind == kind && run.size == size &&
+        memcmp(&buffer[run.offset], data, size) == 0)
+      return run.offset;
+
+  size_t offset = (buffer.size() + alignment - 1) / alignment * alignment;
+  buffer.resize(offset + size);
+  memcpy(&buffer[offset], data, size);
+  runs.push_back(Run{kind, offset, size});
+  return offset;
+}
+
+/**
+ * Vertex data is stored at a multiple of its layout's stride, so that its
+ * first vertex has a whole index in the buffer.
+ */
+Mesh MeshRegistry::add(const float *vertexData, size_t vertexSize,
+                       const GLuint *indexData, size_t indexSize,
+                       std::initializer_list<int> attributes) {
+  std::vector<int> sizes{attributes};
+  size_t layout = 0;
+  while (layout < layouts.size() && layouts[layout].sizes != sizes) layout++;
+  if (layout == layouts.size()) {
+    GLsizei stride = 0;
+    for (int size : sizes) stride += size * sizeof(float);
+    GLuint VAO;
+    glGenVertexArrays(1, &VAO);
+    layouts.push_back(Layout{sizes, stride, VAO});
+  }
+  const Layout &format = layouts[layout];
+  size_t vertexOffset = store(vertexData, vertexSize, (GLuint)layout,
+                              format.stride, vertices, vertexRuns);
+
+  const size_t count = indexSize / sizeof(GLuint);
+  const GLuint largest =
+      count > 0 ? *std::max_element(indexData, indexData + count) : 0;
+  GLenum type = GL_UNSIGNED_INT;
+  size_t width = sizeof(GLuint);
+  if (largest <= UINT8_MAX) {
+    type = GL_UNSIGNED_BYTE;
+    width = sizeof(GLubyte);
+  } else if (largest <= UINT16_MAX) {
+    type = GL_UNSIGNED_SHORT;
+    width = sizeof(GLushort);
+  }
+  std::vector<unsigned char> packed(count * width);
+  for (size_t i = 0; i < count; i++) {
+    if (type == GL_UNSIGNED_BYTE)
+      packed[i] = (GLubyte)indexData[i];
+    else if (type == GL_UNSIGNED_SHORT)
+      ((GLushort *)packed.data())[i] = (GLushort)indexData[i];
+    else
+      ((GLuint *)packed.data())[i] = indexData[i];
+  }
+  size_t indexOffset =
+      store(packed.data(), packed.size(), type, width, indices, indexRuns);
+
+  meshes++;
+  return Mesh{format.VAO, type, (GLsizei)count, (GLintptr)indexOffset,
+              (GLint)(vertexOffset / format.stride)};
+}
+
+void MeshRegistry::attach(const Layout &layout, GLuint VAO) {
+  glBindVertexArray(VAO);
+  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+  size_t offset = 0;
+  for (size_t i = 0; i < layout.sizes.size(); i++) {
+    glVertexAttribPointer(i, layout.sizes[i], GL_FLOAT, GL_FALSE,
+                          layout.stride, (void *)offset);
+    glEnableVertexAttribArray(i);
+    offset += layout.sizes[i] * sizeof(float);
+  }
+}
+
+SELF &MeshRegistry::upload() {
+  tracer::Scope trace{"UPLOAD MESHES"};
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size(), vertices.data(),
+               GL_STATIC_DRAW);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size(), indices.data(),
+               GL_STATIC_DRAW);
+  for (const Layout &layout : layouts) attach(layout, layout.VAO);
+
+  logger::log(logger::level::DEBUG,
+              "Meshes: %zu packed into %zu vertex runs (%zu bytes) and %zu "
+              "index runs (%zu bytes)",
+              meshes, vertexRuns.size(), vertices.size(), indexRuns.size(),
+              indices.size());
+  return *this;
+}
+
+Mesh MeshRegistry::separate(const Mesh &mesh) {
+  Mesh copy = mesh;
+  for (const Layout &layout : layouts)
+    if (layout.VAO == mesh.VAO) {
+      glGenVertexArrays(1, &copy.VAO);
+      attach(layout, copy.VAO);
+      extraVAOs.push_back(copy.VAO);
+    }
+  return copy;
+}
+
+MeshRegistry::~MeshRegistry() {
+  for (const Layout &layout : layouts) glDeleteVertexArrays(1, &layout.VAO);
+  glDeleteVertexArrays(extraVAOs.size(), extraVAOs.data());
+  glDeleteBuffers(1, &VBO);
+  glDeleteBuffers(1, &EBO);
+}
@@ -0,0 +1,176 @@
+/**
+ * @file MeshRegistry.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the registry packing every static mesh into shared buffers.
+ */
+#ifndef MESH_REGISTRY_H
+#define MESH_REGISTRY_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+#include "Include/glad/glad.h"
+#include "Include/glm/glm.hpp"
+
+/**
+ * @brief A mesh packed into the buffers of a MeshRegistry.
+ *
+ * Meshes are small values, which stay valid as long as their registry.
+ *
+ * @see MeshRegistry
+ */
+struct Mesh {
+  // vertex array of the mesh's vertex layout, over the shared buffers
+  GLuint VAO;
+  // GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+  GLenum indexType;
+  GLsizei count;
+  // byte offset of the first index in the shared index buffer
+  GLintptr indexOffset;
+  // index of the first vertex in the shared vertex buffer
+  GLint baseVertex;
+
+  /**
+   * @brief Bind the mesh's vertex array.
+   */
+  void bind() const;
+  /**
+   * @brief Draw the mesh's triangles, with its vertex array bound.
+   */
+  void draw() const;
+  /**
+   * @brief Draw the mesh's triangles at a model matrix, with its vertex array
+   * bound and a shader program active.
+   *
+   * @param model the model matrix
+   * @param location location of the active program's model matrix uniform
+   *
+   * @see Shader::location
+   */
+  void draw(const glm::mat4 &model, GLint location) const;
+  /**
+   * @brief Draw instances of the mesh's triangles, with its vertex array
+   * bound.
+   *
+   * @param instances the amount of instances
+   */
+  void drawInstanced(GLsizei instances) const;
+};
+
+/**
+ * @brief Defines the methods for packing static meshes into one vertex buffer
+ * and one index buffer, shared by every vertex array.
+ *
+ * Vertex data and index lists are each stored once, however many meshes use
+ * them, and each mesh's indices are counted from its own first vertex, drawn
+ * with base vertex draws. Indices are stored in the smallest type that holds
+ * them, which for every mesh of the game is a single byte.
+ *
+ * Meshes sharing a vertex layout share a vertex array, so switching between
+ * them needs no binds at all.
+ */
+class MeshRegistry {
+  using SELF = MeshRegistry;
+
+  /**
+   * @brief Vertex attributes, all of floats, and the vertex array reading
+   * them.
+   */
+  struct Layout {
+    std::vector<int> sizes;
+    GLsizei stride;
+    GLuint VAO;
+  };
+  /**
+   * @brief Bytes stored in one of the buffers, with what they were stored as.
+   */
+  struct Run {
+    // layout of vertex runs, or type of index runs
+    GLuint kind;
+    size_t offset, size;
+  };
+
+  GLuint VBO, EBO;
+  std::vector<Layout> layouts;
+  std::vector<GLuint> extraVAOs;
+  std::vector<unsigned char> vertices, indices;
+  std::vector<Run> vertexRuns, indexRuns;
+  size_t meshes;
+
+  /**
+   * @brief Find bytes already stored, or store them at the next multiple of
+   * an alignment.
+   *
+   * @param data the bytes
+   * @param size amount of bytes
+   * @param kind what the bytes are stored as
+   * @param alignment alignment of their offset
+   * @param buffer the stored bytes
+   * @param runs the runs already stored
+   *
+   * @return the bytes' offset
+   */
+  static size_t store(const void *data, size_t size, GLuint kind,
+                      size_t alignment, std::vector<unsigned char> &buffer,
+                      std::vector<Run> &runs);
+  /**
+   * @brief Point a vertex array's attributes at the shared vertex buffer.
+   *
+   * @param layout the attributes
+   * @param VAO the vertex array
+   */
+  void attach(const Layout &layout, GLuint VAO);
+
+ public:
+  /**
+   * @brief Constructor for the MeshRegistry, creating the shared buffers.
+   */
+  MeshRegistry();
+  MeshRegistry(const MeshRegistry &) = delete;
+  MeshRegistry &operator=(const MeshRegistry &) = delete;
+
+  /**
+   * @brief Add a mesh, reusing any identical vertex data or index list.
+   *
+   * @param vertexData vertex data as an array of floats
+   * @param vertexSize byte size of the vertex data
+   * @param indexData indices as an array of unsigned integers, counted from
+   * the first vertex
+   * @param indexSize byte size of the indices
+   * @param attributes amount of floats of each attribute of a vertex, at
+   * locations counting from 0
+   *
+   * @return the mesh, to be drawn once the registry is uploaded
+   */
+  Mesh add(const float *vertexData, size_t vertexSize, const GLuint *indexData,
+           size_t indexSize, std::initializer_list<int> attributes);
+
+  /**
+   * @brief Upload every mesh added so far and set up their vertex arrays.
+   *
+   * @return reference to the object
+   */
+  SELF &upload();
+
+  /**
+   * @brief Get a mesh with a vertex array of its own, which can be given
+   * more attributes without affecting other meshes.
+   *
+   * @param mesh an uploaded mesh
+   *
+   * @return the same mesh, over a new vertex array
+   */
+  Mesh separate(const Mesh &mesh);
+
+  /**
+   * @brief Destructor for the MeshRegistry, deleting the shared buffers and
+   * every vertex array.
+   */
+  ~MeshRegistry();
+};
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file PartInstances.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class for drawing the Snake's parts as instances.
+ */
+#include "PartInstances.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "GLStats.h"
+#include "Tracer.h"
+#include "constants.h"
+
+using SELF = PartInstances;
+
+PartInstances::PartInstances(size_t maxParts, StreamBuffer *_stream)
+    : capacity{std::max(maxParts, (size_t)1)},
+      stream{_stream},
+      count{0},
+      culled{0} {
+  visible.reserve(capacity);
+  glGenBuffers(1, &VBO);
+  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(snake::PartMotion), NULL,
+               GL_DYNAMIC_DRAW);
+}
+
+void PartInstances::point(GLuint buffer, GLintptr offset) {
+  glBindBuffer(GL_ARRAY_BUFFER, buffer);
+  glVertexAttribPointer(
+      1, 3, GL_FLOAT, GL_FALSE, sizeof(snake::PartMotion),
+      (void *)(offset + offsetof(snake::PartMotion, previous)));
+  glVertexAttribPointer(
+      2, 3, GL_FLOAT, GL_FALSE, sizeof(snake::PartMotion),
+      (void *)(offset + offsetof(snake::PartMotion, current)));
+}
+
+/**
+ * The buffer must be bound to GL_ARRAY_BUFFER.
+ */
+void PartInstances::reserve(size_t instances) {
+  if (instances <= capacity) return;
+  capacity = std::max(instances, capacity * 2);
+  glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(snake::PartMotion), NULL,
+               GL_DYNAMIC_DRAW);
+}
+
+/**
+ * The previous and current positions go to the attributes at locations 1 and
+ * 2, advancing once per instance.
+ */
+SELF &PartInstances::attach() {
+  point(VBO, 0);
+  glEnableVertexAttribArray(1);
+  glVertexAttribDivisor(1, 1);
+  glEnableVertexAttribArray(2);
+  glVertexAttribDivisor(2, 1);
+  return *this;
+}
+
+/**
+ * Parts are culled by the chunk they stand on after the tick. Streamed parts
+ * are written straight into the mapped range, then copied by the GPU into
+ * the object's own buffer, so they outlive the frame's region. The object's
+ * own buffer is only reallocated when the visible parts outgrow it.
+ */
+SELF &PartInstances::upload(const std::vector<snake::PartMotion> &motions,
+                            const ChunkGrid &chunks) {
+  tracer::Scope trace{"UPLOAD INSTANCES"};
+  StreamBuffer::Allocation allocation{NULL, 0};
+  if (stream != NULL)
+    allocation = stream->allocate(motions.size() * sizeof(snake::PartMotion));
+  if (allocation.data != NULL) {
+    auto *instances = (snake::PartMotion *)allocation.data;
+    count = 0;
+    for (const auto &motion : motions)
+      if (chunks.isVisible(motion.current)) instances[count++] = motion;
+    stream->unmap();
+    culled = motions.size() - count;
+    point(VBO, 0);
+    reserve(count);
+    glBindBuffer(GL_COPY_READ_BUFFER, stream->getVBO());
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER,
+                        allocation.offset, 0,
+                        count * sizeof(snake::PartMotion));
+    return *this;
+  }
+
+  visible.clear();
+  for (const auto &motion : motions)
+    if (chunks.isVisible(motion.current)) visible.push_back(motion);
+  count = visible.size();
+  culled = motions.size() - count;
+  point(VBO, 0);
+  reserve(visible.capacity());
+  glBufferSubData(GL_ARRAY_BUFFER, 0,
+                  visible.size() * sizeof(snake::PartMotion), visible.data());
+  return *this;
+}
+
+/**
+ * The mesh the instances were attached to must be bound and the shader
+ * program must be active before this function is called.
+ * @see Mesh
+ * @see Shader
+ */
+SELF &PartInstances::draw(const Mesh &mesh, const Shader &shaderProgram,
+                          float tickAlpha) {
+  shaderProgram.setBool("instanced", true);
+  shaderProgram.setFloat("tickAlpha", tickAlpha);
+  shaderProgram.setFloat("partScale", modelConstants::scale_factor);
+  glstats::countInstances(count, culled);
+  glstats::countDraw();
+  mesh.drawInstanced((GLsizei)count);
+  shaderProgram.setBool("instanced", false);
+  return *this;
+}
+
+PartInstances::~PartInstances() { glDeleteBuffers(1, &VBO); }
@@ -0,0 +1,109 @@
+/**
+ * @file PartInstances.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class for drawing the Snake's parts as instances.
+ */
+#ifndef PART_INSTANCES_H
+#define PART_INSTANCES_H
+
+#include <vector>
+
+#include "ChunkGrid.h"
+#include "Include/glad/glad.h"
+#include "MeshRegistry.h"
+#include "SnakePart.h"
+#include "StreamBuffer.h"
+#include "shader.h"
+
+/**
+ * @brief Defines the methods for drawing every part of the Snake with a
+ * single instanced draw call.
+ *
+ * Each instance holds where its part stood before the latest tick and where
+ * it stands after it, and the vertex shader moves the part between the two by
+ * the fraction of the tick that has gone by, so movement stays continuous at
+ * any frame rate.
+ *
+ * Instances are drawn from the object's own buffer, and only uploaded again
+ * when they change, once per tick or when culling finds other chunks in view.
+ * When a StreamBuffer is given, they are written through it without waiting
+ * on the GPU, then copied into the object's buffer by the GPU. Otherwise, or
+ * when they don't fit in a region, they are written into the object's buffer
+ * directly.
+ */
+class PartInstances {
+  using SELF = PartInstances;
+
+  GLuint VBO;
+  size_t capacity;
+  StreamBuffer *stream;
+  std::vector<snake::PartMotion> visible;
+  size_t count;
+  unsigned long culled;
+
+  /**
+   * @brief Point the instance attributes of the bound vertex array at a
+   * buffer.
+   *
+   * @param buffer buffer holding the instances
+   * @param offset byte offset of the first instance
+   */
+  void point(GLuint buffer, GLintptr offset);
+  /**
+   * @brief Grow the object's own buffer, dropping its contents, if it can't
+   * hold an amount of instances.
+   *
+   * @param instances the amount of instances
+   */
+  void reserve(size_t instances);
+
+ public:
+  /**
+   * @brief Constructor for the PartInstances, creating the instance buffer.
+   *
+   * @param maxParts the amount of parts to reserve memory for up front
+   * @param _stream buffer to stream the instances through, if any
+   */
+  explicit PartInstances(size_t maxParts, StreamBuffer *_stream = NULL);
+  PartInstances(const PartInstances &) = delete;
+  PartInstances &operator=(const PartInstances &) = delete;
+
+  /**
+   * @brief Add the instance attributes to the bound vertex array.
+   *
+   * @return reference to the object
+   */
+  SELF &attach();
+  /**
+   * @brief Upload the parts standing on visible chunks, into the bound vertex
+   * array, to be drawn until the next upload.
+   *
+   * @param motions every part's motion over the latest tick
+   * @param chunks the board's chunks, culled for the current view
+   *
+   * @return reference to the object
+   */
+  SELF &upload(const std::vector<snake::PartMotion> &motions,
+               const ChunkGrid &chunks);
+  /**
+   * @brief Draw every uploaded part.
+   *
+   * @param mesh the cube mesh the instances were attached to, bound
+   * @param shaderProgram main model shader program
+   * @param tickAlpha fraction of the tick gone by, from 0 at the previous
+   * positions to 1 at the current ones
+   *
+   * @return reference to the object
+   */
+  SELF &draw(const Mesh &mesh, const Shader &shaderProgram, float tickAlpha);
+
+  /**
+   * @brief Destructor for the PartInstances, deleting the instance buffer.
+   */
+  ~PartInstances();
+};
+
+#endif
@@ -9,12 +9,7 @@
 #ifndef POINT_H
 #define POINT_H
 
-#include <string>
-
-#include "Include/glad/glad.h"
 #include "Include/glm/glm.hpp"
-#include "Include/glm/gtc/matrix_transform.hpp"
-#include "Include/glm/gtc/type_ptr.hpp"
 /**
  * @brief Defines the methods for the representation of the Point, which is to
  * be caught by the Snake to drive up Score.
@@ -42,16 +37,14 @@ class Point {
    *
    * @return reference to the Point's transform 3D vector
    */
-  glm::vec3& getTrans();
+  glm::vec3 &getTrans();
 
   /**
-   * @brief Draw the Point in 3D space according to each of its vector.
+   * @brief Get the Point's model matrix.
    *
-   * @param shaderID the id of the shader to be used for the model
-   * @param uniformName the name of the uniform for the model matrix
-   * @return reference to the object
+   * @return the Point's 4D model matrix
    */
-  SELF& draw(GLuint shaderID, const std::string& uniformName);
+  glm::mat4 model() const;
 };
 
 #endif
@@ -0,0 +1,164 @@
+/**
+ * @file Profiler.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class for the frame profiler.
+ */
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "Tracer.h"
+
+using SELF = profiler::Profiler;
+
+namespace profiler {
+
+namespace {
+
+const char *const section_names[(int)section::COUNT] = {
+    "INPUT", "TICK", "PLANE", "SNAKE", "POINT", "SCORE", "VIDEO", "SWAP"};
+
+};  // namespace
+
+void Profiler::History::push(float value) {
+  samples[next] = value;
+  next = (next + 1) % profilerConstants::history_size;
+  if (count < profilerConstants::history_size) count++;
+}
+
+/**
+ * The samples are copied to a local array so that the percentile can be
+ * selected without disturbing the window's order.
+ */
+void Profiler::History::stats(float &avg, float &p99) const {
+  avg = p99 = 0.0f;
+  if (count == 0) return;
+
+  float sorted[profilerConstants::history_size];
+  float sum = 0.0f;
+  for (int i = 0; i < count; i++) {
+    sorted[i] = samples[i];
+    sum += samples[i];
+  }
+  avg = sum / count;
+
+  int rank = (count * 99) / 100;
+  std::nth_element(sorted, sorted + rank, sorted + count);
+  p99 = sorted[rank];
+}
+
+Profiler::Profiler() : frame{0}, gpuActive{false} {
+  glGenQueries((int)section::COUNT * profilerConstants::gpu_latency,
+               &queries[0][0]);
+  for (auto &sec : pending)
+    for (bool &slot : sec) slot = false;
+}
+
+/**
+ * A query is only read if its result is available; otherwise its sample is
+ * dropped instead of waiting on the GPU.
+ */
+void Profiler::collect(section sec, int slot) {
+  bool &isPending = pending[(int)sec][slot];
+  if (!isPending) return;
+  isPending = false;
+
+  GLuint query = queries[(int)sec][slot];
+  GLint available = 0;
+  glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available) return;
+
+  GLuint64 nanoseconds = 0;
+  glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+  gpu[(int)sec].push(nanoseconds / 1000.0f);
+}
+
+SELF &Profiler::beginFrame() {
+  frame++;
+  return *this;
+}
+
+/**
+ * Before being reused, the query slot of the current frame is read back, its
+ * result having been issued gpu_latency frames ago.
+ */
+bool Profiler::beginSection(section sec, bool timeGPU) {
+  if (!timeGPU || gpuActive) return false;
+
+  int slot = frame % profilerConstants::gpu_latency;
+  collect(sec, slot);
+  glBeginQuery(GL_TIME_ELAPSED, queries[(int)sec][slot]);
+  gpuActive = true;
+  return true;
+}
+
+void Profiler::endSection(section sec, float microseconds, bool timedGPU) {
+  cpu[(int)sec].push(microseconds);
+  if (!timedGPU) return;
+
+  glEndQuery(GL_TIME_ELAPSED);
+  pending[(int)sec][frame % profilerConstants::gpu_latency] = true;
+  gpuActive = false;
+}
+
+SELF &Profiler::record(section sec, float microseconds) {
+  cpu[(int)sec].push(microseconds);
+  return *this;
+}
+
+/**
+ * Every value is shown in whole microseconds, since the font has no
+ * punctuation. The text is formatted into a fixed buffer, so drawing the
+ * overlay does not allocate.
+ */
+SELF &Profiler::draw(FontRenderer &font) {
+  char line[64];
+  float y = profilerConstants::overlay_y;
+
+  font.writeText("US       CPU   P99   GPU   P99",
+                 profilerConstants::overlay_scale, profilerConstants::overlay_x,
+                 y, 0.3f, 0.5f, "texPos", "model");
+  for (int i = 0; i < (int)section::COUNT; i++) {
+    float cpuAvg, cpuP99, gpuAvg, gpuP99;
+    cpu[i].stats(cpuAvg, cpuP99);
+    gpu[i].stats(gpuAvg, gpuP99);
+    snprintf(line, sizeof(line), "%-5s %5d %5d %5d %5d", section_names[i],
+             (int)cpuAvg, (int)cpuP99, (int)gpuAvg, (int)gpuP99);
+
+    y -= profilerConstants::overlay_line_gap;
+    font.writeText(line, profilerConstants::overlay_scale,
+                   profilerConstants::overlay_x, y, 0.3f, 0.5f, "texPos",
+                   "model");
+  }
+  return *this;
+}
+
+Profiler::~Profiler() {
+  glDeleteQueries((int)section::COUNT * profilerConstants::gpu_latency,
+                  &queries[0][0]);
+}
+
+Scope::Scope(Profiler &_profiler, section _sec, bool timeGPU)
+    : profiler{_profiler},
+      sec{_sec},
+      timedGPU{_profiler.beginSection(_sec, timeGPU)},
+      start{std::chrono::steady_clock::now()} {
+  tracer::begin(section_names[(int)sec]);
+}
+
+/**
+ * Every section is also recorded as a trace event, which is a no-op unless
+ * tracing was started.
+ */
+Scope::~Scope() {
+  std::chrono::duration<float, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  profiler.endSection(sec, elapsed.count(), timedGPU);
+  tracer::end(section_names[(int)sec]);
+}
+
+};  // namespace profiler
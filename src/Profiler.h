@@ -0,0 +1,181 @@
+/**
+ * @file Profiler.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class for the frame profiler.
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+
+#include "FontRenderer.h"
+#include "Include/glad/glad.h"
+#include "constants.h"
+
+/**
+ * @brief Relates to classes and enums concerning frame profiling.
+ */
+namespace profiler {
+
+/**
+ * @brief Represents the profiled sections of a frame.
+ */
+enum class section {
+  INPUT,
+  TICK,
+  PLANE,
+  SNAKE,
+  POINT,
+  SCORE,
+  VIDEO,
+  SWAP,
+  COUNT
+};
+
+/**
+ * @brief Defines the methods for measuring where frame time goes, both on the
+ * CPU and on the GPU.
+ *
+ * GPU times are measured with GL_TIME_ELAPSED queries, which are only read
+ * back profilerConstants::gpu_latency frames later, so that waiting on their
+ * results never stalls the pipeline.
+ *
+ * @see profiler::Scope
+ */
+class Profiler {
+  using SELF = Profiler;
+
+  /**
+   * @brief Rolling window of the latest samples of a section, in
+   * microseconds.
+   */
+  struct History {
+    float samples[profilerConstants::history_size];
+    int next = 0, count = 0;
+
+    /**
+     * @brief Add a sample, replacing the oldest one if the window is full.
+     *
+     * @param value the sample to be added
+     */
+    void push(float value);
+    /**
+     * @brief Compute the average and 99th percentile of the window.
+     *
+     * @param avg filled with the average
+     * @param p99 filled with the 99th percentile
+     */
+    void stats(float &avg, float &p99) const;
+  };
+
+  History cpu[(int)section::COUNT], gpu[(int)section::COUNT];
+  GLuint queries[(int)section::COUNT][profilerConstants::gpu_latency];
+  bool pending[(int)section::COUNT][profilerConstants::gpu_latency];
+  unsigned long frame;
+  bool gpuActive;
+
+  /**
+   * @brief Read a finished GPU query back into its section's history.
+   *
+   * @param sec the section the query belongs to
+   * @param slot the query's position in the section's ring
+   */
+  void collect(section sec, int slot);
+
+ public:
+  /**
+   * @brief Constructor for the Profiler, creating its GPU queries.
+   *
+   * A GL context must be current.
+   */
+  Profiler();
+  Profiler(const Profiler &) = delete;
+  Profiler &operator=(const Profiler &) = delete;
+
+  /**
+   * @brief Mark the start of a new frame.
+   *
+   * @return reference to the object
+   */
+  SELF &beginFrame();
+
+  /**
+   * @brief Start measuring a section.
+   *
+   * @param sec the section to be measured
+   * @param timeGPU whether or not the section's GPU time is also measured
+   *
+   * GPU timing is skipped when another section is already being timed on the
+   * GPU, since GL_TIME_ELAPSED queries cannot overlap.
+   *
+   * @return whether or not GPU timing was started
+   */
+  bool beginSection(section sec, bool timeGPU);
+  /**
+   * @brief Stop measuring a section.
+   *
+   * @param sec the measured section
+   * @param microseconds CPU time spent in the section
+   * @param timedGPU whether or not GPU timing was started for the section
+   */
+  void endSection(section sec, float microseconds, bool timedGPU);
+  /**
+   * @brief Add a CPU sample of a section measured elsewhere, e.g. on another
+   * thread.
+   *
+   * @param sec the measured section
+   * @param microseconds CPU time spent in the section
+   *
+   * @return reference to the object
+   */
+  SELF &record(section sec, float microseconds);
+
+  /**
+   * @brief Draw the rolling average and 99th percentile of every section on
+   * screen.
+   *
+   * @param font font's renderer
+   *
+   * @return reference to the object
+   */
+  SELF &draw(FontRenderer &font);
+
+  /**
+   * @brief Destructor for the Profiler, deleting its GPU queries.
+   */
+  ~Profiler();
+};
+
+/**
+ * @brief Measures a section of the frame for the lifetime of the object.
+ */
+class Scope {
+  Profiler &profiler;
+  section sec;
+  bool timedGPU;
+  std::chrono::steady_clock::time_point start;
+
+ public:
+  /**
+   * @brief Constructor for the Scope, starting the measurement.
+   *
+   * @param _profiler the Profiler receiving the measurement
+   * @param _sec the section being measured
+   * @param timeGPU whether or not the section's GPU time is also measured
+   */
+  Scope(Profiler &_profiler, section _sec, bool timeGPU = false);
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+
+  /**
+   * @brief Destructor for the Scope, ending the measurement.
+   */
+  ~Scope();
+};
+
+};  // namespace profiler
+
+#endif
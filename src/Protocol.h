@@ -0,0 +1,438 @@
+/**
+ * @file Protocol.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Defines the packets exchanged by the game server and its clients.
+ */
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Board.h"
+#include "Include/glm/glm.hpp"
+#include "SnakePart.h"
+
+/**
+ * @brief Relates to networked sessions, where a GameServer steps the game and
+ * GameClients follow it over UDP.
+ *
+ * Clients only send Inputs: the direction they steer towards, and the latest
+ * tick they hold, acknowledging every snapshot up to it.
+ *
+ * The server sends each client a snapshot every tick. A keyframe holds the
+ * whole state, each part of the Snake being a 2-bit step from the one before
+ * it. Any other snapshot holds a Delta per tick since the tick the client
+ * acknowledged: the step taken by the head, whether the Snake grew, and if so
+ * the step to its new tail, and where the food went, if it moved. Deltas are
+ * resent until acknowledged, so a lost snapshot is made up for by the next
+ * one. Clients further behind than
+ * netConstants::history_ticks, in a previous round or out of sync are sent a
+ * keyframe instead.
+ *
+ * Fields are little endian, and cells are 16-bit columns and rows.
+ */
+namespace net {
+
+// identifies packets, and the version of the protocol
+const unsigned char magic[2] = {'S', 'N'};
+const unsigned char version = 1;
+
+/**
+ * @brief Represents the type of a packet, following the magic and version.
+ */
+enum class packet : unsigned char { INPUT = 1, SNAPSHOT = 2 };
+
+// bytes taken by a SnapshotHeader, and by the fields of a Keyframe
+const size_t snapshot_header_size = 28;
+const size_t keyframe_size = 13;
+
+/**
+ * @brief Get the cell next to another, wrapping around the board's edges as
+ * the Snake does.
+ *
+ * @param cell the cell moved from
+ * @param direction the direction moved towards
+ * @param board the board the cell is on
+ *
+ * @return the neighbouring cell
+ */
+inline glm::ivec2 step(glm::ivec2 cell, snake::movement direction,
+                       const Board &board) {
+  switch (direction) {
+    case snake::movement::RIGHT:
+      cell.y--;
+      break;
+    case snake::movement::LEFT:
+      cell.y++;
+      break;
+    case snake::movement::UP:
+      cell.x--;
+      break;
+    case snake::movement::DOWN:
+      cell.x++;
+      break;
+  }
+  cell.x = (cell.x + board.getWidth()) % board.getWidth();
+  cell.y = (cell.y + board.getHeight()) % board.getHeight();
+  return cell;
+}
+
+/**
+ * @brief Find the direction leading from a cell to one of its neighbours.
+ *
+ * @param from the cell moved from
+ * @param to the cell moved to
+ * @param board the board the cells are on
+ * @param found set to the direction found
+ *
+ * @return whether or not the cells are neighbours
+ */
+inline bool direction(glm::ivec2 from, glm::ivec2 to, const Board &board,
+                      snake::movement &found) {
+  for (snake::movement candidate :
+       {snake::movement::RIGHT, snake::movement::LEFT, snake::movement::UP,
+        snake::movement::DOWN})
+    if (step(from, candidate, board) == to) {
+      found = candidate;
+      return true;
+    }
+  return false;
+}
+
+/**
+ * @brief Writes the fields of a packet into a buffer.
+ *
+ * Fields that don't fit are dropped, and the Writer marked as overflowed.
+ */
+class Writer {
+  using SELF = Writer;
+
+  unsigned char *data;
+  size_t capacity, size;
+  bool overflowed;
+
+ public:
+  /**
+   * @brief Constructor for a Writer filling a buffer from its start.
+   *
+   * @param _data the buffer
+   * @param _capacity bytes the buffer holds
+   */
+  Writer(unsigned char *_data, size_t _capacity)
+      : data{_data}, capacity{_capacity}, size{0}, overflowed{false} {}
+
+  /**
+   * @brief Write an unsigned integer of a given amount of bytes.
+   *
+   * @param value the integer, truncated to its lowest bytes
+   * @param bytes amount of bytes written
+   *
+   * @return reference to the object
+   */
+  SELF &put(uint64_t value, int bytes) {
+    if (capacity - size < (size_t)bytes) {
+      overflowed = true;
+      return *this;
+    }
+    for (int i = 0; i < bytes; i++) data[size++] = (value >> (8 * i)) & 0xFF;
+    return *this;
+  }
+  /**
+   * @brief Write a cell, as its column and row.
+   *
+   * @param cell the cell
+   *
+   * @return reference to the object
+   */
+  SELF &put(glm::ivec2 cell) { return put(cell.x, 2).put(cell.y, 2); }
+
+  /**
+   * @brief Get the amount of bytes written.
+   *
+   * @return the amount of bytes
+   */
+  size_t length() const { return size; }
+  /**
+   * @brief Check whether or not every field fit in the buffer.
+   *
+   * @return true if none was dropped, otherwise false
+   */
+  bool ok() const { return !overflowed; }
+};
+
+/**
+ * @brief Reads the fields of a received packet.
+ *
+ * Reading past the end gives zeros, and marks the Reader as failed.
+ */
+class Reader {
+  const unsigned char *data;
+  size_t size, position;
+  bool failed;
+
+ public:
+  /**
+   * @brief Constructor for a Reader starting at a packet's first byte.
+   *
+   * @param _data the packet
+   * @param _size bytes in the packet
+   */
+  Reader(const unsigned char *_data, size_t _size)
+      : data{_data}, size{_size}, position{0}, failed{false} {}
+
+  /**
+   * @brief Read an unsigned integer of a given amount of bytes.
+   *
+   * @param bytes amount of bytes read
+   *
+   * @return the integer
+   */
+  uint64_t get(int bytes) {
+    if (size - position < (size_t)bytes) {
+      failed = true;
+      position = size;
+      return 0;
+    }
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++)
+      value |= (uint64_t)data[position++] << (8 * i);
+    return value;
+  }
+  /**
+   * @brief Read a cell, as its column and row.
+   *
+   * @return the cell
+   */
+  glm::ivec2 cell() {
+    int x = (int)get(2);
+    return glm::ivec2(x, (int)get(2));
+  }
+
+  /**
+   * @brief Check whether or not every field read was in the packet.
+   *
+   * @return true if none was missing, otherwise false
+   */
+  bool ok() const { return !failed; }
+};
+
+/**
+ * @brief Write the magic, version and type starting every packet.
+ *
+ * @param writer the packet's Writer
+ * @param type the packet's type
+ */
+inline void writeHeader(Writer &writer, packet type) {
+  writer.put(magic[0], 1).put(magic[1], 1).put(version, 1).put(
+      (unsigned char)type, 1);
+}
+
+/**
+ * @brief Read the magic, version and type starting every packet.
+ *
+ * @param reader the packet's Reader
+ * @param type the expected type
+ *
+ * @return whether or not the packet is of the protocol's version and the
+ * expected type
+ */
+inline bool readHeader(Reader &reader, packet type) {
+  return reader.get(1) == magic[0] && reader.get(1) == magic[1] &&
+         reader.get(1) == version &&
+         reader.get(1) == (unsigned char)type && reader.ok();
+}
+
+/**
+ * @brief A client's input, sent to the server.
+ */
+struct Input {
+  // round and tick of the latest snapshot the client holds, if any
+  uint16_t round;
+  bool acknowledged;
+  uint32_t tick;
+  snake::movement direction;
+};
+
+/**
+ * @brief Write an Input packet.
+ *
+ * @param writer the packet's Writer
+ * @param input the input
+ */
+inline void write(Writer &writer, const Input &input) {
+  writeHeader(writer, packet::INPUT);
+  writer.put(input.round, 2)
+      .put(input.acknowledged, 1)
+      .put(input.tick, 4)
+      .put((unsigned char)input.direction, 1);
+}
+
+/**
+ * @brief Read an Input packet.
+ *
+ * @param reader the packet's Reader
+ * @param input filled with the input
+ *
+ * @return whether or not the packet is a valid Input
+ */
+inline bool read(Reader &reader, Input &input) {
+  if (!readHeader(reader, packet::INPUT)) return false;
+  input.round = (uint16_t)reader.get(2);
+  input.acknowledged = reader.get(1) != 0;
+  input.tick = (uint32_t)reader.get(4);
+  input.direction = (snake::movement)(reader.get(1) & 3);
+  return reader.ok();
+}
+
+/**
+ * @brief Fields starting every snapshot.
+ */
+struct SnapshotHeader {
+  uint16_t round;
+  bool keyframe;
+  // Deltas following, for the ticks leading up to tick
+  uint8_t deltas;
+  uint32_t tick;
+  // steady clock time the tick was stepped at, in microseconds, so that
+  // clients on the same host can measure their latency
+  uint64_t tickMicros;
+  // the head's cell and the Snake's length as of tick, so that clients can
+  // check the state they rebuilt
+  glm::ivec2 head;
+  uint32_t length;
+};
+
+/**
+ * @brief Fields of a keyframe following its SnapshotHeader, before a 2-bit
+ * step per part after the head, four to a byte.
+ */
+struct Keyframe {
+  // size of the board, in cells
+  uint16_t width, height;
+  uint32_t score;
+  snake::movement direction;
+  glm::ivec2 food;
+};
+
+/**
+ * @brief What changed over one tick.
+ */
+struct Delta {
+  // direction the head stepped towards
+  snake::movement head;
+  // the Snake ate, so a part was added behind its tail
+  bool grew;
+  // step from the part before the new tail to the new tail, which needn't be
+  // the cell the tail left, see snake::Snake::addPart
+  snake::movement tail;
+  bool foodMoved;
+  glm::ivec2 food;
+};
+
+/**
+ * @brief Write the fields starting a snapshot.
+ *
+ * @param writer the packet's Writer
+ * @param header the fields
+ */
+inline void write(Writer &writer, const SnapshotHeader &header) {
+  writeHeader(writer, packet::SNAPSHOT);
+  writer.put(header.round, 2)
+      .put(header.keyframe, 1)
+      .put(header.deltas, 1)
+      .put(header.tick, 4)
+      .put(header.tickMicros, 8)
+      .put(header.head)
+      .put(header.length, 4);
+}
+
+/**
+ * @brief Read the fields starting a snapshot.
+ *
+ * @param reader the packet's Reader
+ * @param header filled with the fields
+ *
+ * @return whether or not the packet starts as a valid snapshot
+ */
+inline bool read(Reader &reader, SnapshotHeader &header) {
+  if (!readHeader(reader, packet::SNAPSHOT)) return false;
+  header.round = (uint16_t)reader.get(2);
+  header.keyframe = reader.get(1) != 0;
+  header.deltas = (uint8_t)reader.get(1);
+  header.tick = (uint32_t)reader.get(4);
+  header.tickMicros = reader.get(8);
+  header.head = reader.cell();
+  header.length = (uint32_t)reader.get(4);
+  return reader.ok();
+}
+
+/**
+ * @brief Write the fields of a keyframe following its SnapshotHeader.
+ *
+ * @param writer the packet's Writer
+ * @param keyframe the fields
+ */
+inline void write(Writer &writer, const Keyframe &keyframe) {
+  writer.put(keyframe.width, 2)
+      .put(keyframe.height, 2)
+      .put(keyframe.score, 4)
+      .put((unsigned char)keyframe.direction, 1)
+      .put(keyframe.food);
+}
+
+/**
+ * @brief Read the fields of a keyframe following its SnapshotHeader.
+ *
+ * @param reader the packet's Reader
+ * @param keyframe filled with the fields
+ *
+ * @return whether or not the fields were in the packet
+ */
+inline bool read(Reader &reader, Keyframe &keyframe) {
+  keyframe.width = (uint16_t)reader.get(2);
+  keyframe.height = (uint16_t)reader.get(2);
+  keyframe.score = (uint32_t)reader.get(4);
+  keyframe.direction = (snake::movement)(reader.get(1) & 3);
+  keyframe.food = reader.cell();
+  return reader.ok();
+}
+
+/**
+ * @brief Write a Delta, as a byte of flags followed by the food's cell if it
+ * moved.
+ *
+ * @param writer the packet's Writer
+ * @param delta the Delta
+ */
+inline void write(Writer &writer, const Delta &delta) {
+  writer.put((unsigned char)delta.head | delta.grew << 2 |
+                 delta.foodMoved << 3 | (unsigned char)delta.tail << 4,
+             1);
+  if (delta.foodMoved) writer.put(delta.food);
+}
+
+/**
+ * @brief Read a Delta.
+ *
+ * @param reader the packet's Reader
+ * @param delta filled with the Delta
+ *
+ * @return whether or not the Delta was in the packet
+ */
+inline bool read(Reader &reader, Delta &delta) {
+  unsigned int flags = (unsigned int)reader.get(1);
+  delta.head = (snake::movement)(flags & 3);
+  delta.grew = flags & 4;
+  delta.foodMoved = flags & 8;
+  delta.tail = (snake::movement)(flags >> 4 & 3);
+  if (delta.foodMoved) delta.food = reader.cell();
+  return reader.ok();
+}
+
+};  // namespace net
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @file Replay.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class for recorded game inputs.
+ */
+#include "Replay.h"
+
+#include <cstdio>
+
+#include "Logger.h"
+
+using SELF = Replay;
+
+namespace {
+
+const char direction_letters[] = {'R', 'L', 'U', 'D'};
+
+};  // namespace
+
+Replay::Replay() : next{0} {}
+
+/**
+ * Reading stops at the first malformed line, keeping the inputs before it.
+ */
+bool Replay::load(const char *path) {
+  FILE *file = fopen(path, "r");
+  if (file == NULL) {
+    logger::log(logger::level::ERROR, "Replay file %s couldn't be opened",
+                path);
+    return false;
+  }
+
+  inputs.clear();
+  next = 0;
+  unsigned long tick;
+  char letter;
+  while (fscanf(file, "%lu %c", &tick, &letter) == 2) {
+    int dir = 0;
+    while (dir < 4 && direction_letters[dir] != letter) dir++;
+    if (dir == 4) {
+      logger::log(logger::level::WARNING,
+                  "Replay %s has an unknown direction %c at tick %lu", path,
+                  letter, tick);
+      break;
+    }
+    inputs.push_back(Input{tick, (snake::movement)dir});
+  }
+  fclose(file);
+  return true;
+}
+
+bool Replay::save(const char *path) const {
+  FILE *file = fopen(path, "w");
+  if (file == NULL) {
+    logger::log(logger::level::ERROR, "Replay file %s couldn't be opened",
+                path);
+    return false;
+  }
+  for (const Input &input : inputs)
+    fprintf(file, "%lu %c\n", input.tick,
+            direction_letters[(int)input.direction]);
+  fclose(file);
+  return true;
+}
+
+SELF &Replay::record(unsigned long tick, snake::movement direction) {
+  if (inputs.empty() || inputs.back().direction != direction)
+    inputs.push_back(Input{tick, direction});
+  return *this;
+}
+
+snake::movement Replay::directionAt(unsigned long tick,
+                                    snake::movement current) {
+  while (next < inputs.size() && inputs[next].tick <= tick)
+    current = inputs[next++].direction;
+  return current;
+}
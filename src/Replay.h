@@ -0,0 +1,86 @@
+/**
+ * @file Replay.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class for recorded game inputs.
+ */
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <vector>
+
+#include "SnakePart.h"
+
+/**
+ * @brief Defines the methods for recording and replaying the direction
+ * changes of a game.
+ *
+ * Inputs are keyed by tick, the amount of times the Snake has moved, so a
+ * replay is independent of frame rate and tick delay. On disk, a replay is a
+ * text file with one input per line, as the tick followed by one of the
+ * letters R, L, U and D.
+ */
+class Replay {
+  using SELF = Replay;
+
+  /**
+   * @brief A direction change, applied before the Snake moves on its tick.
+   */
+  struct Input {
+    unsigned long tick;
+    snake::movement direction;
+  };
+
+  std::vector<Input> inputs;
+  size_t next;
+
+ public:
+  /**
+   * @brief Constructor for an empty Replay.
+   */
+  Replay();
+
+  /**
+   * @brief Replace the inputs with the ones in a replay file.
+   *
+   * @param path path of the file
+   *
+   * @return whether or not the file was read
+   */
+  bool load(const char *path);
+  /**
+   * @brief Write every input to a replay file.
+   *
+   * @param path path of the file
+   *
+   * @return whether or not the file was written
+   */
+  bool save(const char *path) const;
+
+  /**
+   * @brief Add an input, if the direction differs from the latest one.
+   *
+   * @param tick the tick the direction applies from
+   * @param direction the new direction
+   *
+   * @return reference to the object
+   */
+  SELF &record(unsigned long tick, snake::movement direction);
+  /**
+   * @brief Get the direction to apply on a tick, consuming every input up to
+   * it.
+   *
+   * Ticks must be given in increasing order.
+   *
+   * @param tick the current tick
+   * @param current the direction in effect before the tick
+   *
+   * @return the latest recorded direction up to the tick, or current if there
+   * is none
+   */
+  snake::movement directionAt(unsigned long tick, snake::movement current);
+};
+
+#endif
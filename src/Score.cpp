@@ -8,7 +8,7 @@
  */
 #include "Score.h"
 
-#include <iostream>
+#include <cstdio>
 
 using SELF = Score;
 
@@ -22,23 +22,20 @@ Score::Score(unsigned long startingScore, int _max_score_digits)
  *
  * @see Score::makeScoreStr
  */
-SELF& Score::updateScore(unsigned long val) {
+SELF &Score::updateScore(unsigned long val) {
   score += val;
   makeScoreStr();
   return *this;
 }
 
 /**
- * The string is created with trailing zeroes, according to max_score_digits,
- * and assigned to scoreStr.
+ * The string is written in place with leading zeroes, according to
+ * max_score_digits, so no memory is allocated.
  */
-SELF& Score::makeScoreStr() {
-  scoreStr = std::to_string(score);
-  std::string temp;
-  for (size_t i = 0; i < max_score_digits - scoreStr.size(); i++) temp += '0';
-  scoreStr = temp + scoreStr;
+SELF &Score::makeScoreStr() {
+  snprintf(scoreStr, sizeof(scoreStr), "%0*lu", max_score_digits, score);
   return *this;
 }
 
 unsigned long Score::getScore() { return score; }
-std::string& Score::getScoreStr() { return scoreStr; }
+const char *Score::getScoreStr() const { return scoreStr; }
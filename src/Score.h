@@ -9,8 +9,6 @@
 #ifndef SCORE_H
 #define SCORE_H
 
-#include <string>
-
 #include "constants.h"
 /**
  * @brief Defines the methods for the representation of the Score, according to
@@ -26,14 +24,15 @@ class Score {
 
   unsigned long score;
   int max_score_digits;
-  std::string scoreStr;
+  // enough for every digit of an unsigned long, plus the null terminator
+  char scoreStr[21];
 
   /**
    * @brief Create a string of the current score.
    *
    * @return reference to the object
    */
-  SELF& makeScoreStr();
+  SELF &makeScoreStr();
 
  public:
   /**
@@ -52,7 +51,7 @@ class Score {
    *
    * @return reference to the object
    */
-  SELF& updateScore(unsigned long val = 1);
+  SELF &updateScore(unsigned long val = 1);
 
   /**
    * @brief Get the Score value.
@@ -63,9 +62,9 @@ class Score {
   /**
    * @brief Get the string representation of the Score.
    *
-   * @return the string representation of the Score
+   * @return the null-terminated string representation of the Score
    */
-  std::string& getScoreStr();
+  const char *getScoreStr() const;
 };
 
 #endif
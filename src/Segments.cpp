@@ -0,0 +1,143 @@
+/**
+ * @file Segments.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the classes for the straight runs of the Snake.
+ */
+#include "Segments.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Include/glm/gtc/matrix_transform.hpp"
+
+using SELF = snake::Segments;
+
+namespace snake {
+
+namespace {
+
+/**
+ * @brief Check the equality of two positions within the tolerance used for
+ * collisions.
+ *
+ * @param a the first position
+ * @param b the second position
+ *
+ * @return true if they are equal, otherwise false
+ */
+bool sameTrans(const glm::vec3 &a, const glm::vec3 &b) {
+  return std::fabs(a.x - b.x) <= 0.001f && std::fabs(a.z - b.z) <= 0.001f;
+}
+
+};  // namespace
+
+glm::vec3 Segment::tail() const { return head + step * (float)(length - 1); }
+
+glm::vec3 Segment::min() const {
+  glm::vec3 end = tail();
+  return glm::vec3(std::min(head.x, end.x), head.y, std::min(head.z, end.z)) -
+         glm::vec3(scale / 2, scale / 2, scale / 2);
+}
+
+glm::vec3 Segment::max() const {
+  glm::vec3 end = tail();
+  return glm::vec3(std::max(head.x, end.x), head.y, std::max(head.z, end.z)) +
+         glm::vec3(scale / 2, scale / 2, scale / 2);
+}
+
+/**
+ * The parts of a run touch each other, so the stretched cube covers exactly
+ * what drawing each of them would.
+ */
+glm::mat4 Segment::model() const {
+  glm::vec3 end = tail();
+  glm::mat4 model = glm::translate(glm::mat4(1.0f), (head + end) / 2.0f);
+  return glm::scale(model, glm::vec3(std::fabs(end.x - head.x) + scale, scale,
+                                     std::fabs(end.z - head.z) + scale));
+}
+
+Segments::Segments(const glm::vec3 &head, float scale_factor, size_t capacity)
+    : ring(std::max(capacity, (size_t)1)),
+      first{0},
+      count{1},
+      scale{scale_factor} {
+  ring[0] = Segment{head, glm::vec3(0.0f), 1, scale};
+}
+
+Segment &Segments::at(size_t index) {
+  return ring[(first + index) % ring.size()];
+}
+
+void Segments::grow() {
+  std::vector<Segment> larger(ring.size() * 2);
+  for (size_t i = 0; i < count; i++) larger[i] = at(i);
+  ring.swap(larger);
+  first = 0;
+}
+
+/**
+ * A part continues a run when it is the run's next cell along its direction,
+ * or when it sets the direction of a single part run. Parts wrapping around
+ * the board are too far apart to continue a run.
+ */
+bool Segments::continues(const Segment &segment,
+                         const glm::vec3 &offset) const {
+  float distance = std::fabs(offset.x) + std::fabs(offset.z);
+  if (std::fabs(distance - scale) > 0.001f) return false;
+  return segment.length == 1 || sameTrans(segment.step, offset);
+}
+
+SELF &Segments::advanceHead(const glm::vec3 &head) {
+  Segment &front = at(0);
+  glm::vec3 offset = front.head - head;
+  if (continues(front, offset)) {
+    front.head = head;
+    front.step = offset;
+    front.length++;
+    return *this;
+  }
+
+  if (count == ring.size()) grow();
+  first = (first + ring.size() - 1) % ring.size();
+  count++;
+  at(0) = Segment{head, glm::vec3(0.0f), 1, scale};
+  return *this;
+}
+
+SELF &Segments::retractTail() {
+  Segment &back = at(count - 1);
+  if (--back.length == 0 && count > 1) count--;
+  return *this;
+}
+
+SELF &Segments::growTail(const glm::vec3 &tail) {
+  Segment &back = at(count - 1);
+  glm::vec3 offset = tail - back.tail();
+  if (continues(back, offset)) {
+    back.step = offset;
+    back.length++;
+    return *this;
+  }
+
+  if (count == ring.size()) grow();
+  count++;
+  at(count - 1) = Segment{tail, glm::vec3(0.0f), 1, scale};
+  return *this;
+}
+
+size_t Segments::size() const { return count; }
+
+/**
+ * The runs are copied into the vector's memory, so copying does not allocate
+ * unless the vector is outgrown.
+ */
+void Segments::copyTo(std::vector<Segment> &out) const {
+  size_t wrapped = std::min(count, ring.size() - first);
+  out.assign(ring.begin() + first, ring.begin() + first + wrapped);
+  out.insert(out.end(), ring.begin(), ring.begin() + (count - wrapped));
+}
+
+};  // namespace snake
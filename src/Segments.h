@@ -0,0 +1,148 @@
+/**
+ * @file Segments.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the classes for the straight runs of the Snake.
+ */
+#ifndef SEGMENTS_H
+#define SEGMENTS_H
+
+#include <vector>
+
+#include "Include/glm/glm.hpp"
+
+namespace snake {
+
+/**
+ * @brief A straight run of neighboring Snake parts, drawn as a single box.
+ */
+struct Segment {
+  using SELF = Segment;
+
+  // position of the part closest to the head
+  glm::vec3 head;
+  // offset from each part of the run to the next one towards the tail, zero
+  // while the run holds a single part
+  glm::vec3 step;
+  // amount of parts in the run
+  int length;
+  // size of each part
+  float scale;
+
+  /**
+   * @brief Get the position of the part closest to the tail.
+   *
+   * @return the tail end's position 3D vector
+   */
+  glm::vec3 tail() const;
+  /**
+   * @brief Get the lowest corner of the run's box.
+   *
+   * @return the corner's position
+   */
+  glm::vec3 min() const;
+  /**
+   * @brief Get the highest corner of the run's box.
+   *
+   * @return the corner's position
+   */
+  glm::vec3 max() const;
+  /**
+   * @brief Get the model matrix stretching a unit cube over the whole run.
+   *
+   * @return the run's 4D model matrix
+   */
+  glm::mat4 model() const;
+};
+
+/**
+ * @brief Defines the methods for keeping the Snake split into its straight
+ * runs, as it moves and grows.
+ *
+ * The runs are updated with every move of the Snake in constant time, by
+ * stretching or adding a run at the head and shrinking or removing one at
+ * the tail, so their amount follows the Snake's turns rather than its
+ * length. They are kept in a ring, starting from the head's run.
+ */
+class Segments {
+  using SELF = Segments;
+
+  std::vector<Segment> ring;
+  size_t first, count;
+  float scale;
+
+  /**
+   * @brief Get a run by its index, starting from the head's run.
+   *
+   * @param index the run's index
+   *
+   * @return reference to the run
+   */
+  Segment &at(size_t index);
+  /**
+   * @brief Double the ring's capacity, keeping the runs in order.
+   */
+  void grow();
+  /**
+   * @brief Check whether or not a part continues a run.
+   *
+   * @param segment the run
+   * @param offset the offset from the run's end to the new part, pointing
+   * towards the tail
+   *
+   * @return true if it is the case, otherwise false
+   */
+  bool continues(const Segment &segment, const glm::vec3 &offset) const;
+
+ public:
+  /**
+   * @brief Constructor for the runs of a single part Snake.
+   *
+   * @param head the position of the Snake's only part
+   * @param scale_factor the size of each part
+   * @param capacity the amount of runs to reserve memory for up front
+   */
+  Segments(const glm::vec3 &head, float scale_factor, size_t capacity);
+
+  /**
+   * @brief Account for the head moving onto a new position.
+   *
+   * @param head the head's new position
+   *
+   * @return reference to the object
+   */
+  SELF &advanceHead(const glm::vec3 &head);
+  /**
+   * @brief Account for the last part of the tail leaving its position.
+   *
+   * @return reference to the object
+   */
+  SELF &retractTail();
+  /**
+   * @brief Account for a new part added to the end of the tail.
+   *
+   * @param tail the new part's position
+   *
+   * @return reference to the object
+   */
+  SELF &growTail(const glm::vec3 &tail);
+
+  /**
+   * @brief Get the amount of runs.
+   *
+   * @return the amount of runs
+   */
+  size_t size() const;
+  /**
+   * @brief Copy every run, starting from the head's run.
+   *
+   * @param out vector to be filled with the runs
+   */
+  void copyTo(std::vector<Segment> &out) const;
+};
+
+};  // namespace snake
+
+#endif
@@ -0,0 +1,191 @@
+/**
+ * @file Simulation.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class running the game's simulation.
+ */
+#include "Simulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <string>
+
+#include "AllocationTracker.h"
+#include "GameRules.h"
+#include "Logger.h"
+#include "Tracer.h"
+#include "constants.h"
+
+using SELF = Simulation;
+
+Snapshot::Snapshot(size_t maxParts)
+    : point{glm::vec3(0.0f, 0.0f, 0.0f), modelConstants::scale_factor},
+      tick{0},
+      period{0.0},
+      tickMicros{0.0f},
+      collided{false} {
+  motions.reserve(maxParts);
+  segments.reserve(maxParts / 2 + 2);
+}
+
+Simulation::Simulation(snake::Snake &_snek, Point &_point, Score &_score,
+                       const Board &_board, TickSounds *_sounds,
+                       Replay *_recorder, size_t maxParts)
+    : snek{_snek},
+      point{_point},
+      score{_score},
+      board{_board},
+      sounds{_sounds},
+      recorder{_recorder},
+      tick{0},
+      snapshots{maxParts},
+      baseRate{1.0 / settingConstants::delay},
+      ramp{false},
+      threaded{false},
+      stopping{false} {
+  previous.reserve(maxParts);
+  publish(0.0f, false);
+}
+
+/**
+ * The parts are copied into memory reserved up front, so publishing does not
+ * allocate unless the Snake outgrows it. A part added on the tick starts out
+ * where it stands.
+ */
+void Simulation::publish(float tickMicros, bool collided) {
+  Snapshot &next = snapshots.writeSlot();
+  const std::vector<snake::SnakePart> &parts = snek.getParts();
+  next.motions.resize(parts.size());
+  for (size_t i = 0; i < parts.size(); i++) {
+    const glm::vec3 &trans = parts[i].getTrans();
+    if (i == previous.size()) previous.push_back(trans);
+    next.motions[i] = snake::PartMotion{previous[i], trans};
+    previous[i] = trans;
+  }
+  snek.getSegments().copyTo(next.segments);
+  next.point = point;
+  next.score = score;
+  next.tick = tick;
+  next.published = std::chrono::steady_clock::now();
+  next.period = threaded ? 1.0 / tickRate() : 0.0;
+  next.tickMicros = tickMicros;
+  next.collided = collided;
+  snapshots.publish();
+}
+
+bool Simulation::step(snake::movement direction) {
+  tracer::Scope trace{"TICK"};
+  auto start = std::chrono::steady_clock::now();
+
+  if (recorder != nullptr) {
+    // only direction changes are stored, and the replay is opt-in
+    allocation::Exempt store;
+    recorder->record(tick, direction);
+  }
+  snek.updateDirection(direction);
+  snek.move();
+  tick++;
+
+  bool collided = snek.selfCollision();
+  if (!collided && snek.pointCollisionHead(point.getTrans())) {
+    score.updateScore();
+    snek.addPart();
+    if (sounds != nullptr) sounds->ate(snek.getHeadTrans());
+    // a Snake filling the whole board has nowhere left to go
+    collided = !relocatePoint(snek, point, board);
+  } else if (!collided && sounds != nullptr) {
+    sounds->moved(snek.getHeadTrans());
+  }
+
+  std::chrono::duration<float, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  publish(elapsed.count(), collided);
+  return collided;
+}
+
+/**
+ * The rate is capped at tickConstants::max_rate, however high the score.
+ */
+double Simulation::tickRate() {
+  double rate = baseRate;
+  if (ramp) rate *= std::pow(tickConstants::ramp_factor, score.getScore());
+  return std::min(rate, tickConstants::max_rate);
+}
+
+/**
+ * Ticks are scheduled against the monotonic clock, one period apart, and the
+ * wait between them is cut short as soon as the simulation is stopped. Late
+ * ticks are run back to back to catch up, unless the simulation fell more
+ * than tickConstants::max_catch_up periods behind, in which case the missed
+ * ticks are dropped.
+ */
+void Simulation::run(const std::atomic<snake::movement> &input) {
+  using clock = std::chrono::steady_clock;
+  tracer::nameThread("simulation");
+  auto period = [this] {
+    return std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>(1.0 / tickRate()));
+  };
+  const clock::time_point begin = clock::now();
+  clock::time_point next = begin + period();
+  unsigned long ticks = 0, dropped = 0;
+
+  std::unique_lock<std::mutex> lock{stopMutex};
+  while (!stopSignal.wait_until(lock, next, [this] { return stopping; })) {
+    lock.unlock();
+    const clock::duration interval = period();
+    next += interval;
+    clock::duration behind = clock::now() - next;
+    if (behind > interval * tickConstants::max_catch_up) {
+      long missed = behind / interval;
+      dropped += missed;
+      next += interval * missed;
+      tracer::instant("DROPPED TICKS");
+    }
+
+    allocation::FrameScope frame;
+    bool collided = step(input.load(std::memory_order_relaxed));
+    ticks++;
+    lock.lock();
+    if (collided) break;
+  }
+
+  std::chrono::duration<double> elapsed = clock::now() - begin;
+  logger::log(logger::level::INFO,
+              "Simulation ran %lu ticks in %.2f s, %.1f ticks/s sustained, "
+              "%lu dropped, ending at %.1f ticks/s",
+              ticks, elapsed.count(), ticks / elapsed.count(), dropped,
+              tickRate());
+}
+
+SELF &Simulation::start(const std::atomic<snake::movement> &input,
+                        double rate, bool _ramp) {
+  baseRate = std::max(rate, 0.1);
+  ramp = _ramp;
+  threaded = true;
+  stopping = false;
+  worker = std::thread(&Simulation::run, this, std::cref(input));
+  return *this;
+}
+
+SELF &Simulation::stop() {
+  if (!worker.joinable()) return *this;
+  {
+    std::lock_guard<std::mutex> lock{stopMutex};
+    stopping = true;
+  }
+  stopSignal.notify_one();
+  worker.join();
+  threaded = false;
+  return *this;
+}
+
+bool Simulation::update() { return snapshots.update(); }
+
+Snapshot &Simulation::snapshot() { return snapshots.readSlot(); }
+
+Simulation::~Simulation() { stop(); }
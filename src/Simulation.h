@@ -0,0 +1,176 @@
+/**
+ * @file Simulation.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class running the game's simulation.
+ */
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Board.h"
+#include "Point.h"
+#include "Replay.h"
+#include "Score.h"
+#include "Snake.h"
+#include "TickSounds.h"
+#include "TripleBuffer.h"
+
+/**
+ * @brief The state of the game after a tick, as needed to render it.
+ */
+struct Snapshot {
+  // every part's motion over the tick, starting from the head
+  std::vector<snake::PartMotion> motions;
+  // straight runs of the parts, starting from the head's run
+  std::vector<snake::Segment> segments;
+  Point point;
+  Score score;
+  unsigned long tick;
+  // when the tick was published
+  std::chrono::steady_clock::time_point published;
+  // seconds until the next tick is due, or 0 when ticks are stepped manually
+  double period;
+  // CPU time spent on the tick, in microseconds
+  float tickMicros;
+  // whether or not the game ended on the tick
+  bool collided;
+
+  /**
+   * @brief Constructor for an empty Snapshot.
+   *
+   * @param maxParts the amount of parts to reserve memory for up front
+   */
+  explicit Snapshot(size_t maxParts);
+};
+
+/**
+ * @brief Defines the methods for ticking the game, either on demand or on
+ * its own thread at its tick rate.
+ *
+ * The Snake, Point and Score belong to the simulation while its thread runs.
+ * At high tick rates, many ticks may run within a single rendered frame.
+ * After every tick, their state is published as a Snapshot through a triple
+ * buffer, so that rendering never waits on a tick and a tick never waits on
+ * rendering.
+ */
+class Simulation {
+  using SELF = Simulation;
+
+  snake::Snake &snek;
+  Point &point;
+  Score &score;
+  Board board;
+  TickSounds *sounds;
+  Replay *recorder;
+  unsigned long tick;
+  TripleBuffer<Snapshot> snapshots;
+  // every part's position as of the latest published tick
+  std::vector<glm::vec3> previous;
+
+  double baseRate;
+  bool ramp;
+  bool threaded;
+  std::thread worker;
+  std::mutex stopMutex;
+  std::condition_variable stopSignal;
+  bool stopping;
+
+  /**
+   * @brief Publish the current state as the latest Snapshot.
+   *
+   * @param tickMicros CPU time spent on the tick, in microseconds
+   * @param collided whether or not the game ended
+   */
+  void publish(float tickMicros, bool collided);
+  /**
+   * @brief Get the current tick rate.
+   *
+   * @return the rate in ticks per second
+   */
+  double tickRate();
+  /**
+   * @brief Tick at the tick rate until stopped or the Snake runs into itself,
+   * then log the sustained tick rate.
+   *
+   * @param input the direction given by the player
+   */
+  void run(const std::atomic<snake::movement> &input);
+
+ public:
+  /**
+   * @brief Constructor for the Simulation, publishing the initial state.
+   *
+   * @param _snek game Snake
+   * @param _point game Point
+   * @param _score game Score
+   * @param _board the board the game is played on
+   * @param _sounds plays the sounds of each tick, if any
+   * @param _recorder replay the input of each tick is recorded into, if any
+   * @param maxParts the longest the Snake is expected to grow
+   */
+  Simulation(snake::Snake &_snek, Point &_point, Score &_score,
+             const Board &_board, TickSounds *_sounds, Replay *_recorder,
+             size_t maxParts);
+  Simulation(const Simulation &) = delete;
+  Simulation &operator=(const Simulation &) = delete;
+
+  /**
+   * @brief Run a single tick and publish its Snapshot.
+   *
+   * Must not be called while the thread is running.
+   *
+   * @param direction the direction given for the tick
+   *
+   * @return whether or not the game ended, the Snake having run into itself
+   * or filled the board
+   */
+  bool step(snake::movement direction);
+
+  /**
+   * @brief Start ticking on a separate thread.
+   *
+   * @param input the direction given by the player, read on every tick
+   * @param rate ticks per second to start at
+   * @param _ramp whether or not the rate grows by
+   * tickConstants::ramp_factor with every point scored
+   *
+   * @return reference to the object
+   */
+  SELF &start(const std::atomic<snake::movement> &input, double rate,
+              bool _ramp);
+  /**
+   * @brief Stop the thread, if running, and wait for it to finish.
+   *
+   * @return reference to the object
+   */
+  SELF &stop();
+
+  /**
+   * @brief Pick up the latest Snapshot, if there is a new one.
+   *
+   * @return whether or not a new Snapshot was picked up
+   */
+  bool update();
+  /**
+   * @brief Get the latest Snapshot picked up.
+   *
+   * @return reference to the Snapshot
+   */
+  Snapshot &snapshot();
+
+  /**
+   * @brief Destructor for the Simulation, stopping its thread.
+   */
+  ~Simulation();
+};
+
+#endif
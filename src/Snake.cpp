@@ -35,14 +35,15 @@ constexpr bool floatEquality(float a, float b, float e) {
 
 Snake::Snake(glm::vec3 startTransHead, int startingSize, float scale_factor,
              float increment_val, float borderx, float borderz,
-             movement startDir)
-    : scaleFactor{scale_factor},
+             movement startDir, size_t maxSize)
+    : segments{startTransHead, scale_factor, maxSize / 2 + 2},
+      scaleFactor{scale_factor},
       increment{increment_val},
       borderx{borderx},
       borderz{borderz},
       generalDirection{startDir} {
-  SnakePart *head = new SnakePart(startTransHead, scale_factor, startDir);
-  parts.push_back(head);
+  parts.reserve(maxSize);
+  parts.emplace_back(startTransHead, scale_factor, startDir);
   for (int i = 1; i < startingSize; i++) addPart();
 }
 
@@ -52,13 +53,13 @@ Snake::Snake(glm::vec3 startTransHead, int startingSize, float scale_factor,
  * in the opposite direction, as to thus increase the size of the tail.
  */
 SELF &Snake::addPart() {
-  auto *last = parts.back();
-  movement dir = last->getDirection();
-  auto trans = last->getTrans();
-  SnakePart *part = new SnakePart(trans, scaleFactor, invertDirection(dir));
-  part->move(increment, borderx, borderz);
-  part->updateDirection(dir);
+  movement dir = parts.back().getDirection();
+  auto trans = parts.back().getTrans();
+  SnakePart part{trans, scaleFactor, invertDirection(dir)};
+  part.move(increment, borderx, borderz);
+  part.updateDirection(dir);
   parts.push_back(part);
+  segments.growTail(part.getTrans());
 
   return *this;
 }
@@ -69,43 +70,33 @@ SELF &Snake::addPart() {
  */
 SELF &Snake::updateDirection(movement newHeadDir) {
   if (newHeadDir != invertDirection(generalDirection))
-    parts[0]->updateDirection(newHeadDir);
+    parts[0].updateDirection(newHeadDir);
   return *this;
 }
 
 /**
  * Each part of the Snake is moved according to the increment by a call to each
  * part's move function. Afterwards, each part is updated with the direction of
- * the part in front of it, with the exception of the head.
+ * the part in front of it, with the exception of the head. The straight runs
+ * are then stretched at the head and shrunk at the tail.
  */
 SELF &Snake::move() {
-  parts[0]->move(increment, borderx, borderz);
-  movement old = parts[0]->getDirection();
+  parts[0].move(increment, borderx, borderz);
+  movement old = parts[0].getDirection();
   generalDirection = old;
   for (size_t i = 1; i < parts.size(); i++) {
-    parts[i]->move(increment, borderx, borderz);
-    old = parts[i]->updateDirection(old);
+    parts[i].move(increment, borderx, borderz);
+    old = parts[i].updateDirection(old);
   }
+  segments.advanceHead(parts[0].getTrans()).retractTail();
 
   return *this;
 }
 
-/**
- * A cube shape must be bound and a shader program must be active before this
- * function is called.
- * @see Shape3D
- * @see Shader
- * @see snake::SnakePart::draw
- */
-SELF &Snake::draw(GLuint shaderID, const std::string &uniformName) {
-  for (auto *part : parts) part->draw(shaderID, uniformName);
-  return *this;
-}
-
 bool Snake::selfCollision() const {
-  glm::vec3 headTrans = parts[0]->getTrans();
+  glm::vec3 headTrans = parts[0].getTrans();
   for (size_t i = 1; i < parts.size(); i++) {
-    glm::vec3 temp = parts[i]->getTrans();
+    glm::vec3 temp = parts[i].getTrans();
     if (floatEquality(temp.x, headTrans.x, 0.001f) &&
         floatEquality(temp.z, headTrans.z, 0.001f))
       return true;
@@ -114,14 +105,14 @@ bool Snake::selfCollision() const {
 }
 
 bool Snake::pointCollisionHead(const glm::vec3 &pointTrans) const {
-  glm::vec3 headTrans = parts[0]->getTrans();
+  glm::vec3 headTrans = parts[0].getTrans();
   return (floatEquality(headTrans.x, pointTrans.x, 0.001f) &&
           floatEquality(headTrans.z, pointTrans.z, 0.001f));
 }
 
 bool Snake::pointCollisionAll(const glm::vec3 &pointTrans) const {
-  for (auto *part : parts) {
-    glm::vec3 trans = part->getTrans();
+  for (const auto &part : parts) {
+    glm::vec3 trans = part.getTrans();
     if (floatEquality(trans.x, pointTrans.x, 0.001f) &&
         floatEquality(trans.z, pointTrans.z, 0.001f))
       return true;
@@ -129,10 +120,11 @@ bool Snake::pointCollisionAll(const glm::vec3 &pointTrans) const {
   return false;
 }
 
-/**
- * Deletes all of the previously created SnakePart associated with the Snake.
- */
-Snake::~Snake() {
-  for (auto *part : parts) delete part;
-}
+glm::vec3 Snake::getHeadTrans() const { return parts[0].getTrans(); }
+
+size_t Snake::getLength() const { return parts.size(); }
+
+const std::vector<SnakePart> &Snake::getParts() const { return parts; }
+
+const Segments &Snake::getSegments() const { return segments; }
 };  // namespace snake
@@ -11,6 +11,7 @@
 
 #include <vector>
 
+#include "Segments.h"
 #include "SnakePart.h"
 
 namespace snake {
@@ -23,7 +24,8 @@ namespace snake {
  */
 class Snake {
   using SELF = Snake;
-  std::vector<SnakePart *> parts;
+  std::vector<SnakePart> parts;
+  Segments segments;
   float scaleFactor, increment, borderx, borderz;
   movement generalDirection;
 
@@ -41,11 +43,13 @@ class Snake {
    * @param borderx the limit of the plane the snake stands on in the x axis
    * @param borderz the limit of the plane the snake stands on in the z axis
    * @param startDir the initial direction of movement of the Snake
+   * @param maxSize the amount of parts to reserve memory for up front, so
+   * that growing up to it never allocates
    * @see snake::SnakePart
    */
   Snake(glm::vec3 startTransHead, int startingSize, float scale_factor,
         float increment_val, float borderx, float borderz,
-        movement startDir = movement::DOWN);
+        movement startDir = movement::DOWN, size_t maxSize = 0);
 
   /**
    * @brief Add a SnakePart to the end of the Snake's tail.
@@ -69,14 +73,6 @@ class Snake {
    * @see snake::SnakePart::move
    */
   SELF &move();
-  /**
-   * @brief Draw the Snake in 3D space according to each of its parts' vectors.
-   *
-   * @param shaderID the id of the shader to be used for the models
-   * @param uniformName the name of the uniform for the model matrix
-   * @return reference to the object
-   */
-  SELF &draw(GLuint shaderID, const std::string &uniformName);
 
   /**
    * @brief Check if the Snake's head is occupying the same space as any of its
@@ -104,9 +100,29 @@ class Snake {
   bool pointCollisionAll(const glm::vec3 &pointTrans) const;
 
   /**
-   * @brief Destructor of the whole Snake.
+   * @brief Get the position of the Snake's head.
+   *
+   * @return the head's position as a 3D vector
+   */
+  glm::vec3 getHeadTrans() const;
+  /**
+   * @brief Get the amount of parts of the Snake.
+   *
+   * @return the Snake's length
+   */
+  size_t getLength() const;
+  /**
+   * @brief Get every part of the Snake, starting from the head.
+   *
+   * @return reference to the parts
+   */
+  const std::vector<SnakePart> &getParts() const;
+  /**
+   * @brief Get the straight runs the Snake's parts form.
+   *
+   * @return reference to the runs
    */
-  ~Snake();
+  const Segments &getSegments() const;
 };
 
 /**
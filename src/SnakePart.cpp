@@ -9,10 +9,29 @@
 
 #include "SnakePart.h"
 
+#include <cmath>
+
 using SELF = snake::SnakePart;
 
 namespace snake {
 
+namespace {
+
+/**
+ * @brief Snap a coordinate onto the grid of half increments, which holds
+ * every cell center.
+ *
+ * @param value the coordinate
+ * @param increment the distance between neighboring cells
+ *
+ * @return the closest grid coordinate
+ */
+float snap(float value, float increment) {
+  return std::round(value * 2 / increment) * increment / 2;
+}
+
+};  // namespace
+
 SnakePart::SnakePart(glm::vec3 startTrans, float scale_factor,
                      movement startDir)
     : trans{startTrans},
@@ -23,38 +42,42 @@ SnakePart::SnakePart(glm::vec3 startTrans, float scale_factor,
  * According to the current direction, defines movement by the given
  * increment in the corresponding axis. In the case the part goes beyond the
  * border, makes it so the part is moved to the opposite side of the plane.
+ *
+ * Moved coordinates are snapped back onto the grid, so that rounding errors
+ * don't build up as the part travels across large boards.
  */
-SELF& SnakePart::move(float increment, float borderx, float borderz) {
+SELF &SnakePart::move(float increment, float borderx, float borderz) {
   switch (direction) {
     case movement::RIGHT:
       if (trans.z - increment < -borderz - 0.001f)
         trans.z = -trans.z;
       else
-        trans = glm::vec3(trans.x, trans.y, trans.z - increment);
+        trans.z = snap(trans.z - increment, increment);
       break;
     case movement::LEFT:
       if (trans.z + increment > borderz + 0.001f)
         trans.z = -trans.z;
       else
-        trans = glm::vec3(trans.x, trans.y, trans.z + increment);
+        trans.z = snap(trans.z + increment, increment);
       break;
     case movement::UP:
       if (trans.x - increment < -borderx - 0.001f)
         trans.x = -trans.x;
       else
-        trans = glm::vec3(trans.x - increment, trans.y, trans.z);
+        trans.x = snap(trans.x - increment, increment);
       break;
     case movement::DOWN:
       if (trans.x + increment > borderx + 0.001f)
         trans.x = -trans.x;
       else
-        trans = glm::vec3(trans.x + increment, trans.y, trans.z);
+        trans.x = snap(trans.x + increment, increment);
       break;
   }
   return *this;
 }
 
-glm::vec3& SnakePart::getTrans() { return trans; }
+glm::vec3 &SnakePart::getTrans() { return trans; }
+const glm::vec3 &SnakePart::getTrans() const { return trans; }
 
 movement SnakePart::getDirection() const { return direction; }
 
@@ -64,23 +87,10 @@ movement SnakePart::updateDirection(movement newDirection) {
   return old;
 }
 
-/**
- * A cube shape must be bound and a shader program must be active before this
- * function is called.
- * @see Shape3D
- * @see Shader
- */
-SELF& SnakePart::draw(GLuint shaderID, const std::string& uniformName) {
+glm::mat4 SnakePart::model() const {
   glm::mat4 model = glm::mat4(1.0f);
   model = glm::translate(model, trans);
-  model = glm::scale(model, scale);
-
-  glUniformMatrix4fv(glGetUniformLocation(shaderID, uniformName.c_str()), 1,
-                     GL_FALSE, glm::value_ptr(model));
-
-  glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-
-  return *this;
+  return glm::scale(model, scale);
 }
 
 };  // namespace snake
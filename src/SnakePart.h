@@ -12,10 +12,8 @@
 
 #include <string>
 
-#include "Include/glad/glad.h"
 #include "Include/glm/glm.hpp"
 #include "Include/glm/gtc/matrix_transform.hpp"
-#include "Include/glm/gtc/type_ptr.hpp"
 
 /**
  * @brief Relates to classes, enums and methods concerning the Snake and its
@@ -28,6 +26,13 @@ namespace snake {
  */
 enum class movement { RIGHT, LEFT, UP, DOWN };
 
+/**
+ * @brief Where a Snake part stood before a tick, and where it stands after it.
+ */
+struct PartMotion {
+  glm::vec3 previous, current;
+};
+
 /**
  * @brief Defines the methods for the behavior of each part of the Snake.
  */
@@ -57,14 +62,20 @@ class SnakePart {
    *
    * @return reference to the object
    */
-  SELF& move(float increment, float borderx, float borderz);
+  SELF &move(float increment, float borderx, float borderz);
 
   /**
    * @brief Get a reference to the part's transform vector.
    *
    * @return reference to the part's transform 3D vector
    */
-  glm::vec3& getTrans();
+  glm::vec3 &getTrans();
+  /**
+   * @brief Get a constant reference to the part's transform vector.
+   *
+   * @return constant reference to the part's transform 3D vector
+   */
+  const glm::vec3 &getTrans() const;
 
   /**
    * @brief Get the current direction of the Snake part.
@@ -81,15 +92,12 @@ class SnakePart {
    * @see snake::movement
    */
   movement updateDirection(movement newDirection);
-
   /**
-   * @brief Draw the Snake part in 3D space according to its vectors.
+   * @brief Get the part's model matrix.
    *
-   * @param shaderID the id of the shader to be used for the part
-   * @param uniformName the name of the uniform for the part's model matrix
-   * @return reference to the object
+   * @return the part's 4D model matrix
    */
-  SELF& draw(GLuint shaderID, const std::string& uniformName);
+  glm::mat4 model() const;
 };
 
 };  // namespace snake
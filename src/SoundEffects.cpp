@@ -0,0 +1,45 @@
+/**
+ * @file SoundEffects.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class playing the sounds of the game's ticks.
+ */
+#include "SoundEffects.h"
+
+#include <chrono>
+
+#include "Tracer.h"
+#include "constants.h"
+
+SoundEffects::SoundEffects(const Camera &camera) {
+  move.setListener(camera);
+  food.setListener(camera);
+}
+
+/**
+ * Submitting to the pool neither creates a thread nor allocates, so sounds
+ * are allowed in the tick. A sound still queued after
+ * audioConstants::max_sound_delay is dropped, as it would no longer match the
+ * screen.
+ */
+void SoundEffects::play(AudioHandler &handler, const std::string &path,
+                        glm::vec3 source) {
+  auto queued = std::chrono::steady_clock::now();
+  soundTasks.submit(tasks::priority::HIGH, [&handler, &path, source, queued] {
+    std::chrono::duration<double> delay =
+        std::chrono::steady_clock::now() - queued;
+    if (delay.count() > audioConstants::max_sound_delay) return;
+    tracer::Scope trace{"SOUND"};
+    handler.playAudio(path, 0.2f, source);
+  });
+}
+
+void SoundEffects::moved(const glm::vec3 &head) {
+  play(move, audioConstants::move_path, head);
+}
+
+void SoundEffects::ate(const glm::vec3 &head) {
+  play(food, audioConstants::food_path, head);
+}
@@ -0,0 +1,52 @@
+/**
+ * @file SoundEffects.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class playing the sounds of the game's ticks.
+ */
+#ifndef SOUND_EFFECTS_H
+#define SOUND_EFFECTS_H
+
+#include <string>
+
+#include "AudioHandler.h"
+#include "Include/glm/glm.hpp"
+#include "TaskPool.h"
+#include "TickSounds.h"
+#include "camera.h"
+
+/**
+ * @brief Plays the move and food sounds on the task pool, positioned
+ * relative to the Camera.
+ */
+class SoundEffects : public TickSounds {
+  AudioHandler move, food;
+  // sounds still playing, waited for before the handlers go away
+  tasks::Group soundTasks;
+
+  /**
+   * @brief Play a sound effect on the task pool.
+   *
+   * @param handler the handler playing it
+   * @param path the path of the .wav file
+   * @param source position of the sound in 3D space
+   */
+  void play(AudioHandler &handler, const std::string &path, glm::vec3 source);
+
+ public:
+  /**
+   * @brief Constructor for the SoundEffects.
+   *
+   * @param camera scene Camera, used as the audio listener
+   */
+  explicit SoundEffects(const Camera &camera);
+  SoundEffects(const SoundEffects &) = delete;
+  SoundEffects &operator=(const SoundEffects &) = delete;
+
+  void moved(const glm::vec3 &head) override;
+  void ate(const glm::vec3 &head) override;
+};
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file StreamBuffer.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class for streaming dynamic vertex data.
+ */
+#include "StreamBuffer.h"
+
+#include "Logger.h"
+#include "Tracer.h"
+
+using SELF = StreamBuffer;
+
+StreamBuffer::StreamBuffer(size_t _regionSize)
+    : regionSize{_regionSize},
+      offset{0},
+      region{0},
+      regionsUsed{0},
+      stalls{0} {
+  for (GLsync &fence : fences) fence = NULL;
+  glGenBuffers(1, &VBO);
+  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  glBufferData(GL_ARRAY_BUFFER, regionSize * streamConstants::regions, NULL,
+               GL_STREAM_DRAW);
+}
+
+/**
+ * The fence is first polled, so waiting is only traced and counted when the
+ * GPU is actually behind.
+ */
+void StreamBuffer::advance() {
+  fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  region = (region + 1) % streamConstants::regions;
+  offset = 0;
+  regionsUsed++;
+
+  GLsync &fence = fences[region];
+  if (fence == NULL) return;
+  if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) ==
+      GL_TIMEOUT_EXPIRED) {
+    tracer::Scope trace{"STREAM WAIT"};
+    stalls++;
+    glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+  }
+  glDeleteSync(fence);
+  fence = NULL;
+}
+
+StreamBuffer::Allocation StreamBuffer::allocate(size_t bytes) {
+  if (bytes == 0 || bytes > regionSize) return Allocation{NULL, 0};
+  size_t start = (offset + streamConstants::alignment - 1) &
+                 ~(streamConstants::alignment - 1);
+  if (start + bytes > regionSize) {
+    advance();
+    start = 0;
+  }
+
+  GLintptr position = (GLintptr)(region * regionSize + start);
+  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  void *data = glMapBufferRange(GL_ARRAY_BUFFER, position, bytes,
+                                GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+                                    GL_MAP_INVALIDATE_RANGE_BIT);
+  if (data == NULL) return Allocation{NULL, 0};
+  offset = start + bytes;
+  return Allocation{data, position};
+}
+
+SELF &StreamBuffer::unmap() {
+  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  return *this;
+}
+
+SELF &StreamBuffer::endFrame() {
+  if (offset > 0) advance();
+  return *this;
+}
+
+StreamBuffer::~StreamBuffer() {
+  for (GLsync fence : fences)
+    if (fence != NULL) glDeleteSync(fence);
+  glDeleteBuffers(1, &VBO);
+  logger::log(logger::level::DEBUG,
+              "Stream buffer: %lu regions used, waited on %lu", regionsUsed,
+              stalls);
+}
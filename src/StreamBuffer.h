@@ -0,0 +1,105 @@
+/**
+ * @file StreamBuffer.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class for streaming dynamic vertex data.
+ */
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#include <cstddef>
+
+#include "Include/glad/glad.h"
+#include "constants.h"
+
+/**
+ * @brief Defines the methods for sub-allocating dynamic vertex data from a
+ * single buffer, without the driver synchronizing or reallocating it.
+ *
+ * The buffer is split into streamConstants::regions regions, and each frame
+ * allocates from the next one. Allocations are written through unsynchronized
+ * and invalidating mappings, which never wait on the GPU. Instead, a fence is
+ * placed when a frame leaves its region, and only waited for when the region
+ * comes around again, by which time the GPU is normally done with it. A frame
+ * outgrowing its region moves on to the next one early.
+ *
+ * Each allocation must be drawn from before the next one is made, so that
+ * the fence of its region covers the draw.
+ */
+class StreamBuffer {
+  using SELF = StreamBuffer;
+
+  GLuint VBO;
+  size_t regionSize, offset;
+  int region;
+  GLsync fences[streamConstants::regions];
+  unsigned long regionsUsed, stalls;
+
+  /**
+   * @brief Fence the current region and move on to the next one, waiting for
+   * the GPU to be done with it if needed.
+   */
+  void advance();
+
+ public:
+  /**
+   * @brief A range of the buffer, mapped for writing.
+   */
+  struct Allocation {
+    // where to write the data, or null if the allocation failed
+    void *data;
+    // byte offset of the data in the buffer, to draw from
+    GLintptr offset;
+  };
+
+  /**
+   * @brief Constructor for the StreamBuffer, creating the buffer.
+   *
+   * @param _regionSize bytes each region holds
+   */
+  explicit StreamBuffer(size_t _regionSize = streamConstants::region_size);
+  StreamBuffer(const StreamBuffer &) = delete;
+  StreamBuffer &operator=(const StreamBuffer &) = delete;
+
+  /**
+   * @brief Allocate and map a range of the current frame's region.
+   *
+   * @param bytes size of the range
+   *
+   * @return the mapped range, whose data is null if it would not fit in a
+   * region or couldn't be mapped
+   */
+  Allocation allocate(size_t bytes);
+  /**
+   * @brief Finish writing the latest allocation, before drawing from it.
+   *
+   * @return reference to the object
+   */
+  SELF &unmap();
+
+  /**
+   * @brief End the frame, so that the next one allocates from a new region.
+   *
+   * Frames that allocated nothing leave the region as it is.
+   *
+   * @return reference to the object
+   */
+  SELF &endFrame();
+
+  /**
+   * @brief Get the buffer object's name.
+   *
+   * @return the name, to point vertex attributes at
+   */
+  GLuint getVBO() const { return VBO; }
+
+  /**
+   * @brief Destructor for the StreamBuffer, deleting the buffer and logging
+   * how often the GPU had to be waited for.
+   */
+  ~StreamBuffer();
+};
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * @file TaskPool.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the pool of worker threads shared by all background work.
+ */
+#include "TaskPool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Logger.h"
+#include "Tracer.h"
+
+namespace {
+
+/**
+ * @brief Ring of the tasks waiting at one priority.
+ */
+struct Queue {
+  tasks::Task slots[taskConstants::queue_capacity];
+  size_t head = 0;
+  size_t count = 0;
+};
+
+/**
+ * @brief Add a task at the back of a queue, which must have room for it.
+ */
+void push(Queue &queue, tasks::Task &task) {
+  size_t tail = (queue.head + queue.count) % taskConstants::queue_capacity;
+  queue.slots[tail].take(task);
+  queue.count++;
+}
+
+/**
+ * @brief Take the task at the front of a queue, which must not be empty.
+ */
+void pop(Queue &queue, tasks::Task &task) {
+  task.take(queue.slots[queue.head]);
+  queue.head = (queue.head + 1) % taskConstants::queue_capacity;
+  queue.count--;
+}
+
+std::mutex mutex;
+std::condition_variable available;
+// indexed by priority, so that the first non-empty queue is the most urgent
+Queue queues[3];
+std::vector<std::thread> workers;
+bool running = false;
+bool stopping = false;
+
+// tasks for the main thread, guarded by their own mutex so that posting them
+// doesn't contend with the workers
+std::mutex mainMutex;
+std::condition_variable posted, room;
+Queue mainQueue;
+// namespace scope objects are initialized on the main thread, before main
+const std::thread::id mainThread = std::this_thread::get_id();
+
+/**
+ * @brief Runs queued tasks until the pool stops and every queue is empty.
+ */
+void work() {
+  tracer::nameThread("task worker");
+  tasks::Task task;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock{mutex};
+      Queue *queue = NULL;
+      available.wait(lock, [&queue] {
+        for (Queue &q : queues)
+          if (q.count > 0) {
+            queue = &q;
+            return true;
+          }
+        return stopping;
+      });
+      if (queue == NULL) return;
+      pop(*queue, task);
+    }
+    task.run();
+  }
+}
+
+};  // namespace
+
+namespace tasks {
+
+void start(unsigned int count) {
+  std::lock_guard<std::mutex> lock{mutex};
+  if (running) return;
+  if (count == 0)
+    count = std::min(std::max(std::thread::hardware_concurrency(),
+                              taskConstants::min_workers),
+                     taskConstants::max_workers);
+  running = true;
+  stopping = false;
+  workers.reserve(count);
+  for (unsigned int i = 0; i < count; i++) workers.emplace_back(work);
+  logger::log(logger::level::DEBUG, "Task pool started %u workers", count);
+}
+
+void stop() {
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (!running) return;
+    stopping = true;
+  }
+  available.notify_all();
+  for (std::thread &worker : workers) worker.join();
+  workers.clear();
+  std::lock_guard<std::mutex> lock{mutex};
+  running = false;
+}
+
+bool enqueue(priority p, Task &task) {
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    Queue &queue = queues[(int)p];
+    if (!running || stopping ||
+        queue.count == taskConstants::queue_capacity)
+      return false;
+    push(queue, task);
+  }
+  available.notify_one();
+  return true;
+}
+
+bool enqueueMain(Task &task, bool wait) {
+  {
+    std::unique_lock<std::mutex> lock{mainMutex};
+    if (mainQueue.count == taskConstants::queue_capacity) {
+      if (!wait) return false;
+      // the main thread would wait on itself
+      if (std::this_thread::get_id() == mainThread) {
+        lock.unlock();
+        task.run();
+        return true;
+      }
+      room.wait(lock, [] {
+        return mainQueue.count < taskConstants::queue_capacity;
+      });
+    }
+    push(mainQueue, task);
+  }
+  posted.notify_one();
+  return true;
+}
+
+/**
+ * Only the main thread takes from its queue, so the Tasks counted on entry
+ * are still queued when taken.
+ */
+unsigned int drain(bool block) {
+  size_t queued;
+  {
+    std::unique_lock<std::mutex> lock{mainMutex};
+    if (block) posted.wait(lock, [] { return mainQueue.count > 0; });
+    queued = mainQueue.count;
+  }
+  Task task;
+  for (size_t i = 0; i < queued; i++) {
+    {
+      std::lock_guard<std::mutex> lock{mainMutex};
+      pop(mainQueue, task);
+    }
+    room.notify_one();
+    task.run();
+  }
+  return (unsigned int)queued;
+}
+
+void Group::finish() {
+  std::lock_guard<std::mutex> lock{mutex};
+  if (--pending == 0) done.notify_all();
+}
+
+void Group::wait() {
+  std::unique_lock<std::mutex> lock{mutex};
+  done.wait(lock, [this] { return pending == 0; });
+}
+
+};  // namespace tasks
@@ -0,0 +1,321 @@
+/**
+ * @file TaskPool.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the pool of worker threads shared by all background work.
+ */
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "constants.h"
+
+/**
+ * @brief Relates to the engine-wide pool background work runs on.
+ *
+ * A fixed set of workers, started once, runs the sounds, the music, the asset
+ * loading and the replay writing, so no thread is created while the game runs
+ * and the threads busy with background work never outnumber the workers.
+ *
+ * Tasks wait in one fixed-capacity queue per priority, stored inline in its
+ * slots, so submitting one performs no allocation and is allowed within an
+ * allocation::FrameScope. Workers always take the oldest task of the highest
+ * priority queued.
+ *
+ * Work that has to happen on the thread owning the GL context, such as
+ * uploading what a worker loaded, is queued for the main thread instead,
+ * which runs it when it calls tasks::drain once per frame.
+ */
+namespace tasks {
+
+/**
+ * @brief Represents how urgently a task should run.
+ *
+ * HIGH is meant for work the player notices when late, such as sound effects,
+ * NORMAL for loading and LOW for work nobody waits on.
+ */
+enum class priority { HIGH, NORMAL, LOW };
+
+/**
+ * @brief A function and its captures, stored inline so that queueing it
+ * needs no allocation.
+ *
+ * The function must fit in taskConstants::task_size bytes. Larger ones are
+ * given to tasks::async instead.
+ */
+class Task {
+  using SELF = Task;
+
+  enum class operation { RUN, MOVE, DESTROY };
+
+  alignas(std::max_align_t) unsigned char storage[taskConstants::task_size];
+  // runs, moves or destroys the function held in storage, null when empty
+  void (*operate)(operation op, void *from, void *to);
+
+ public:
+  /**
+   * @brief Constructor for an empty Task.
+   */
+  Task() : operate{NULL} {}
+  /**
+   * @brief Constructor for a Task holding a function.
+   *
+   * @param function callable with no arguments, copied or moved into the Task
+   */
+  template <typename F>
+  explicit Task(F &&function) {
+    using Function = typename std::decay<F>::type;
+    static_assert(sizeof(Function) <= taskConstants::task_size,
+                  "captures too large for a Task, use tasks::async");
+    static_assert(alignof(Function) <= alignof(std::max_align_t),
+                  "captures too aligned for a Task");
+    new (storage) Function(std::forward<F>(function));
+    operate = [](operation op, void *from, void *to) {
+      Function *held = static_cast<Function *>(from);
+      if (op == operation::RUN) (*held)();
+      if (op == operation::MOVE) new (to) Function(std::move(*held));
+      held->~Function();
+    };
+  }
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+
+  /**
+   * @brief Check whether or not the Task holds a function.
+   *
+   * @return true if empty, otherwise false
+   */
+  bool empty() const { return operate == NULL; }
+  /**
+   * @brief Move the function of another Task into this one, which must be
+   * empty.
+   *
+   * @param other the Task given up, left empty
+   *
+   * @return reference to the object
+   */
+  SELF &take(Task &other) {
+    other.operate(operation::MOVE, other.storage, storage);
+    operate = other.operate;
+    other.operate = NULL;
+    return *this;
+  }
+  /**
+   * @brief Run the function, then destroy it, leaving the Task empty.
+   */
+  void run() {
+    void (*held)(operation, void *, void *) = operate;
+    operate = NULL;
+    held(operation::RUN, storage, NULL);
+  }
+
+  /**
+   * @brief Destructor for the Task, destroying the function if never run.
+   */
+  ~Task() {
+    if (operate != NULL) operate(operation::DESTROY, storage, NULL);
+  }
+};
+
+/**
+ * @brief Starts the workers.
+ *
+ * @param workers amount of workers, or 0 to match the hardware's threads
+ * within taskConstants::min_workers and taskConstants::max_workers
+ *
+ * Calling it while the pool is running does nothing.
+ */
+void start(unsigned int workers = 0);
+
+/**
+ * @brief Runs every queued task and stops the workers.
+ *
+ * Tasks can't be submitted from then on.
+ */
+void stop();
+
+/**
+ * @brief Queues a Task to be run by a worker.
+ *
+ * @param p the priority of the task
+ * @param task the Task, left empty once queued
+ *
+ * @return whether or not the Task was queued, which fails while the pool isn't
+ * running or when the queue of its priority is full
+ *
+ * Safe to call from any thread, and never allocates.
+ */
+bool enqueue(priority p, Task &task);
+
+/**
+ * @brief Queues a function to be run by a worker.
+ *
+ * @param p the priority of the task
+ * @param function callable with no arguments, stored inline as a Task
+ *
+ * @return whether or not the function was queued, see tasks::enqueue
+ */
+template <typename F>
+bool submit(priority p, F &&function) {
+  Task task{std::forward<F>(function)};
+  return enqueue(p, task);
+}
+
+/**
+ * @brief Runs a function on a worker, giving a future for its result.
+ *
+ * @param p the priority of the task
+ * @param function callable with no arguments, of any size
+ *
+ * @return future for the function's result, or for the exception it threw
+ *
+ * Allocates the shared state of the future, so not meant for the frame loop.
+ * If the function can't be queued, it is run on the spot instead of lost.
+ */
+template <typename F>
+auto async(priority p, F &&function) -> std::future<decltype(function())> {
+  using Result = decltype(function());
+  auto task = std::make_shared<std::packaged_task<Result()>>(
+      std::forward<F>(function));
+  std::future<Result> result = task->get_future();
+  if (!submit(p, [task] { (*task)(); })) (*task)();
+  return result;
+}
+
+/**
+ * @brief Queues a Task to be run on the main thread, by its next call to
+ * tasks::drain.
+ *
+ * @param task the Task, left empty once queued
+ * @param wait whether or not to wait for room when the main thread's queue is
+ * full, rather than fail; the main thread itself runs the Task on the spot
+ *
+ * @return whether or not the Task was queued or run
+ *
+ * Safe to call from any thread, and never allocates.
+ */
+bool enqueueMain(Task &task, bool wait = false);
+
+/**
+ * @brief Queues a function to be run on the main thread, by its next call to
+ * tasks::drain.
+ *
+ * @param function callable with no arguments, stored inline as a Task
+ *
+ * @return whether or not the function was queued, see tasks::enqueueMain
+ */
+template <typename F>
+bool submitMain(F &&function) {
+  Task task{std::forward<F>(function)};
+  return enqueueMain(task);
+}
+
+/**
+ * @brief Runs the Tasks queued for the main thread.
+ *
+ * @param block whether or not to wait for a Task when none is queued
+ *
+ * @return amount of Tasks run
+ *
+ * Must only be called from the main thread. Tasks queued while draining are
+ * left for the next call.
+ */
+unsigned int drain(bool block = false);
+
+/**
+ * @brief Runs a function on a worker, then a continuation on the main thread.
+ *
+ * @param p the priority of the function
+ * @param function callable with no arguments, of any size
+ * @param continuation callable taking a ready future for the function's
+ * result, or for the exception it threw, run by the main thread's next call
+ * to tasks::drain
+ *
+ * Allocates as tasks::async does. If the function can't be queued, it is run
+ * on the spot instead of lost, and its continuation still queued.
+ */
+template <typename F, typename C>
+void asyncThen(priority p, F &&function, C &&continuation) {
+  using Result = decltype(function());
+  using Continuation = typename std::decay<C>::type;
+  auto task = std::make_shared<std::packaged_task<Result()>>(
+      std::forward<F>(function));
+  auto result = std::make_shared<std::future<Result>>(task->get_future());
+  auto next = std::make_shared<Continuation>(std::forward<C>(continuation));
+  auto chain = [task, result, next] {
+    (*task)();
+    Task followUp{[result, next] { (*next)(std::move(*result)); }};
+    enqueueMain(followUp, true);
+  };
+  if (!submit(p, chain)) chain();
+}
+
+/**
+ * @brief Counts the tasks submitted on behalf of an owner, so it can wait for
+ * them before anything they use is destroyed.
+ */
+class Group {
+  std::mutex mutex;
+  std::condition_variable done;
+  unsigned int pending;
+
+  /**
+   * @brief Count a task of the Group as run, waking its waiters if it was the
+   * last one.
+   */
+  void finish();
+
+ public:
+  /**
+   * @brief Constructor for a Group without tasks.
+   */
+  Group() : pending{0} {}
+  Group(const Group &) = delete;
+  Group &operator=(const Group &) = delete;
+
+  /**
+   * @brief Queues a function to be run by a worker, counted by the Group.
+   *
+   * @param p the priority of the task
+   * @param function callable with no arguments, stored inline as a Task
+   *
+   * @return whether or not the function was queued, see tasks::enqueue
+   */
+  template <typename F>
+  bool submit(priority p, F &&function) {
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      pending++;
+    }
+    bool queued =
+        tasks::submit(p, [this, held = std::forward<F>(function)]() mutable {
+          held();
+          finish();
+        });
+    if (!queued) finish();
+    return queued;
+  }
+  /**
+   * @brief Blocks until every task of the Group has run.
+   */
+  void wait();
+
+  /**
+   * @brief Destructor for the Group, waiting for its tasks.
+   */
+  ~Group() { wait(); }
+};
+
+};  // namespace tasks
+
+#endif
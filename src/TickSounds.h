@@ -0,0 +1,38 @@
+/**
+ * @file TickSounds.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the interface a Simulation plays its sounds through.
+ */
+#ifndef TICK_SOUNDS_H
+#define TICK_SOUNDS_H
+
+#include "Include/glm/glm.hpp"
+
+/**
+ * @brief Plays the sounds of a tick's events on behalf of a Simulation, so
+ * that the simulation doesn't depend on how, or whether, they are heard.
+ *
+ * @see SoundEffects
+ */
+class TickSounds {
+ public:
+  /**
+   * @brief Play the sound of the Snake moving.
+   *
+   * @param head position of the Snake's head
+   */
+  virtual void moved(const glm::vec3 &head) = 0;
+  /**
+   * @brief Play the sound of the Snake eating the Point.
+   *
+   * @param head position of the Snake's head
+   */
+  virtual void ate(const glm::vec3 &head) = 0;
+
+  virtual ~TickSounds() {}
+};
+
+#endif
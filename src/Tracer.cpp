@@ -0,0 +1,202 @@
+/**
+ * @file Tracer.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the trace event recording functions.
+ */
+#include "Tracer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Logger.h"
+#include "constants.h"
+
+namespace tracer {
+
+namespace {
+
+/**
+ * @brief A single recorded event.
+ */
+struct Event {
+  const char *name;
+  double ts;
+  unsigned int tid;
+  char phase;
+};
+
+/**
+ * @brief Events recorded by a thread.
+ *
+ * Only the owning thread writes to it; the count is published with release
+ * semantics so the buffer can be read at any time.
+ */
+struct Buffer {
+  Event events[traceConstants::buffer_events];
+  std::atomic<size_t> count{0};
+};
+
+/**
+ * @brief The tracer's shared state.
+ */
+struct State {
+  std::mutex mutex;  // guards everything below but recording and dropped
+  std::vector<std::unique_ptr<Buffer>> buffers;
+  std::vector<Buffer *> released;
+  std::vector<std::pair<unsigned int, const char *>> names;
+  unsigned int nextTid = 1;
+  std::string path;
+  std::chrono::steady_clock::time_point origin;
+  std::atomic<bool> recording{false};
+  std::atomic<unsigned long> dropped{0};
+};
+
+State &state() {
+  static State s;
+  return s;
+}
+
+/**
+ * @brief The calling thread's hold on a Buffer.
+ *
+ * Threads come and go, e.g. one per sound effect, so once a thread exits its
+ * buffer is handed over to the next thread instead of being kept aside.
+ * Events carry their thread ID, so a buffer may hold events of many threads.
+ */
+struct Holder {
+  Buffer *buffer = nullptr;
+  unsigned int tid = 0;
+  bool named = false;
+
+  ~Holder() {
+    if (buffer == nullptr) return;
+    std::lock_guard<std::mutex> lock{state().mutex};
+    state().released.push_back(buffer);
+  }
+};
+
+thread_local Holder holder;
+
+Holder &acquire() {
+  if (holder.buffer == nullptr) {
+    State &s = state();
+    std::lock_guard<std::mutex> lock{s.mutex};
+    holder.tid = s.nextTid++;
+    if (!s.released.empty()) {
+      holder.buffer = s.released.back();
+      s.released.pop_back();
+    } else {
+      s.buffers.emplace_back(new Buffer);
+      holder.buffer = s.buffers.back().get();
+    }
+  }
+  return holder;
+}
+
+void record(const char *name, char phase) {
+  State &s = state();
+  if (!s.recording.load(std::memory_order_relaxed)) return;
+
+  Holder &h = acquire();
+  size_t n = h.buffer->count.load(std::memory_order_relaxed);
+  if (n >= traceConstants::buffer_events) {
+    s.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  std::chrono::duration<double, std::micro> ts =
+      std::chrono::steady_clock::now() - s.origin;
+  h.buffer->events[n] = Event{name, ts.count(), h.tid, phase};
+  h.buffer->count.store(n + 1, std::memory_order_release);
+}
+
+};  // namespace
+
+void start(const char *path) {
+  State &s = state();
+  std::lock_guard<std::mutex> lock{s.mutex};
+  s.path = path;
+  s.origin = std::chrono::steady_clock::now();
+  s.recording.store(true, std::memory_order_release);
+}
+
+/**
+ * Threads that are still running may keep recording into their buffers while
+ * they are written out; only the events published before each buffer is read
+ * are included.
+ */
+bool stop() {
+  State &s = state();
+  if (!s.recording.exchange(false)) return false;
+
+  std::lock_guard<std::mutex> lock{s.mutex};
+  FILE *file = fopen(s.path.c_str(), "w");
+  if (file == NULL) {
+    logger::log(logger::level::ERROR, "Trace file %s couldn't be opened",
+                s.path.c_str());
+    return false;
+  }
+
+  const char *separator = "";
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  for (auto &name : s.names) {
+    fprintf(file,
+            "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+            "\"args\":{\"name\":\"%s\"}}",
+            separator, name.first, name.second);
+    separator = ",";
+  }
+  for (auto &buffer : s.buffers) {
+    size_t count = buffer->count.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+      const Event &event = buffer->events[i];
+      fprintf(file,
+              "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,"
+              "\"tid\":%u%s}",
+              separator, event.name, event.phase, event.ts, event.tid,
+              event.phase == 'i' ? ",\"s\":\"t\"" : "");
+      separator = ",";
+    }
+  }
+  fprintf(file, "\n]}\n");
+  fclose(file);
+
+  unsigned long lost = s.dropped.exchange(0);
+  if (lost > 0)
+    logger::log(logger::level::WARNING, "%lu trace events dropped", lost);
+  return true;
+}
+
+bool enabled() { return state().recording.load(std::memory_order_relaxed); }
+
+void nameThread(const char *name) {
+  if (!enabled()) return;
+  Holder &h = acquire();
+  if (h.named) return;
+  h.named = true;
+  std::lock_guard<std::mutex> lock{state().mutex};
+  state().names.emplace_back(h.tid, name);
+}
+
+void begin(const char *name) { record(name, 'B'); }
+void end(const char *name) { record(name, 'E'); }
+void instant(const char *name) { record(name, 'i'); }
+
+Scope::Scope(const char *_name) : name{_name}, active{enabled()} {
+  if (active) begin(name);
+}
+
+Scope::~Scope() {
+  if (active) end(name);
+}
+
+};  // namespace tracer
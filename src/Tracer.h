@@ -0,0 +1,100 @@
+/**
+ * @file Tracer.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the trace event recording functions.
+ */
+#ifndef TRACER_H
+#define TRACER_H
+
+/**
+ * @brief Relates to recording timelines in the Chrome trace event format.
+ *
+ * Each thread records its events into its own buffer without taking any lock.
+ * Once stopped, every buffer is written into a JSON file that can be opened in
+ * chrome://tracing or Perfetto.
+ *
+ * Recording is opt-in: until tracer::start is called, every function returns
+ * right away. Event names must be string literals, since only their pointers
+ * are stored.
+ */
+namespace tracer {
+
+/**
+ * @brief Starts recording events.
+ *
+ * @param path path of the JSON file written by tracer::stop
+ */
+void start(const char *path);
+
+/**
+ * @brief Stops recording and writes every recorded event to the file given to
+ * tracer::start.
+ *
+ * @return whether or not the file was written
+ */
+bool stop();
+
+/**
+ * @brief Check whether or not events are being recorded.
+ *
+ * @return true if recording, otherwise false
+ */
+bool enabled();
+
+/**
+ * @brief Names the calling thread in the trace.
+ *
+ * @param name the thread's name
+ *
+ * Only the first name given to a thread is kept.
+ */
+void nameThread(const char *name);
+
+/**
+ * @brief Records the beginning of a duration event on the calling thread.
+ *
+ * @param name the event's name
+ */
+void begin(const char *name);
+/**
+ * @brief Records the end of the latest duration event on the calling thread.
+ *
+ * @param name the event's name
+ */
+void end(const char *name);
+/**
+ * @brief Records an instant event on the calling thread.
+ *
+ * @param name the event's name
+ */
+void instant(const char *name);
+
+/**
+ * @brief Records a duration event for the lifetime of the object.
+ */
+class Scope {
+  const char *name;
+  bool active;
+
+ public:
+  /**
+   * @brief Constructor for the Scope, beginning the event.
+   *
+   * @param _name the event's name
+   */
+  Scope(const char *_name);
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+
+  /**
+   * @brief Destructor for the Scope, ending the event.
+   */
+  ~Scope();
+};
+
+};  // namespace tracer
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * @file TripleBuffer.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Defines and implements the lock-free triple buffer.
+ */
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+/**
+ * @brief Defines the methods for handing the latest value from one writer
+ * thread to one reader thread, without either ever waiting on the other.
+ *
+ * Of the three slots, the writer owns one, the reader owns another, and the
+ * third sits in the middle holding the latest published value. Publishing and
+ * picking up swap a slot with the middle one, so values are never copied and
+ * a value being read is never written to. Values published while the reader
+ * is busy are overwritten by newer ones, as only the latest one matters.
+ */
+template <typename T>
+class TripleBuffer {
+  using SELF = TripleBuffer;
+
+  // set in middle when it holds a value the reader has not picked up
+  static const unsigned int fresh = 4;
+
+  T slots[3];
+  unsigned int back, front;
+  std::atomic<unsigned int> middle;
+
+ public:
+  /**
+   * @brief Constructor for the TripleBuffer.
+   *
+   * @param args arguments every slot is constructed with
+   */
+  template <typename... Args>
+  explicit TripleBuffer(const Args &...args)
+      : slots{T(args...), T(args...), T(args...)},
+        back{0},
+        front{1},
+        middle{2} {}
+  TripleBuffer(const TripleBuffer &) = delete;
+  TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+  /**
+   * @brief Get the writer's slot, to be filled before publishing it.
+   *
+   * @return reference to the slot
+   */
+  T &writeSlot() { return slots[back]; }
+
+  /**
+   * @brief Publish the writer's slot as the latest value.
+   *
+   * Only to be called from the writer thread.
+   *
+   * @return reference to the object
+   */
+  SELF &publish() {
+    back = middle.exchange(back | fresh, std::memory_order_acq_rel) & ~fresh;
+    return *this;
+  }
+
+  /**
+   * @brief Pick up the latest published value, if there is a new one.
+   *
+   * Only to be called from the reader thread.
+   *
+   * @return whether or not a new value was picked up
+   */
+  bool update() {
+    if (!(middle.load(std::memory_order_relaxed) & fresh)) return false;
+    front = middle.exchange(front, std::memory_order_acq_rel) & ~fresh;
+    return true;
+  }
+
+  /**
+   * @brief Get the reader's slot, holding the latest value picked up.
+   *
+   * @return reference to the slot
+   */
+  T &readSlot() { return slots[front]; }
+};
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file UdpSocket.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class for sending and receiving UDP datagrams.
+ */
+#include "UdpSocket.h"
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include "Logger.h"
+
+namespace net {
+
+Address loopback(uint16_t port) {
+  Address address;
+  address.host = 0x7F000001;
+  address.port = port;
+  return address;
+}
+
+#ifndef _WIN32
+
+namespace {
+
+sockaddr_in toSockaddr(const Address &address) {
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(address.host);
+  addr.sin_port = htons(address.port);
+  return addr;
+}
+
+};  // namespace
+
+UdpSocket::UdpSocket(uint16_t port) : fd{-1} {
+  fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    logger::log(logger::level::ERROR, "UDP socket couldn't be created: %s",
+                strerror(errno));
+    return;
+  }
+  sockaddr_in addr = toSockaddr(loopback(port));
+  if (bind(fd, (const sockaddr *)&addr, sizeof(addr)) != 0) {
+    logger::log(logger::level::ERROR, "UDP port %u couldn't be bound: %s",
+                (unsigned)port, strerror(errno));
+    close(fd);
+    fd = -1;
+  }
+}
+
+bool UdpSocket::isOpen() const { return fd >= 0; }
+
+uint16_t UdpSocket::port() const {
+  if (fd < 0) return 0;
+  sockaddr_in addr;
+  socklen_t length = sizeof(addr);
+  if (getsockname(fd, (sockaddr *)&addr, &length) != 0) return 0;
+  return ntohs(addr.sin_port);
+}
+
+bool UdpSocket::send(const Address &to, const unsigned char *data,
+                     size_t size) {
+  if (fd < 0) return false;
+  sockaddr_in addr = toSockaddr(to);
+  return sendto(fd, data, size, 0, (const sockaddr *)&addr, sizeof(addr)) ==
+         (ssize_t)size;
+}
+
+/**
+ * The wait is done through select, as it takes microseconds, so that fixed
+ * ticks are kept without oversleeping.
+ */
+long UdpSocket::receive(unsigned char *data, size_t capacity, Address &from,
+                        long timeoutMicros) {
+  if (fd < 0) return -1;
+  fd_set readable;
+  FD_ZERO(&readable);
+  FD_SET(fd, &readable);
+  timeval timeout;
+  timeout.tv_sec = timeoutMicros > 0 ? timeoutMicros / 1000000 : 0;
+  timeout.tv_usec = timeoutMicros > 0 ? timeoutMicros % 1000000 : 0;
+  if (select(fd + 1, &readable, NULL, NULL, &timeout) <= 0) return -1;
+
+  sockaddr_in addr;
+  socklen_t length = sizeof(addr);
+  ssize_t got =
+      recvfrom(fd, data, capacity, 0, (sockaddr *)&addr, &length);
+  if (got < 0) return -1;
+  from.host = ntohl(addr.sin_addr.s_addr);
+  from.port = ntohs(addr.sin_port);
+  return (long)got;
+}
+
+UdpSocket::~UdpSocket() {
+  if (fd >= 0) close(fd);
+}
+
+#else
+
+UdpSocket::UdpSocket(uint16_t port) : fd{-1} {
+  logger::log(logger::level::ERROR,
+              "UDP sockets are only supported on POSIX systems");
+}
+
+bool UdpSocket::isOpen() const { return false; }
+
+uint16_t UdpSocket::port() const { return 0; }
+
+bool UdpSocket::send(const Address &to, const unsigned char *data,
+                     size_t size) {
+  return false;
+}
+
+long UdpSocket::receive(unsigned char *data, size_t capacity, Address &from,
+                        long timeoutMicros) {
+  return -1;
+}
+
+UdpSocket::~UdpSocket() {}
+
+#endif
+
+};  // namespace net
@@ -0,0 +1,106 @@
+/**
+ * @file UdpSocket.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class for sending and receiving UDP datagrams.
+ */
+#ifndef UDP_SOCKET_H
+#define UDP_SOCKET_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace net {
+
+/**
+ * @brief An IPv4 address and port, in host byte order.
+ */
+struct Address {
+  uint32_t host = 0;
+  uint16_t port = 0;
+
+  bool operator==(const Address &other) const {
+    return host == other.host && port == other.port;
+  }
+};
+
+/**
+ * @brief Get the loopback address of a port.
+ *
+ * @param port the port
+ *
+ * @return the address
+ */
+Address loopback(uint16_t port);
+
+/**
+ * @brief A UDP socket bound to the loopback interface.
+ *
+ * Sessions are meant to be run and measured on a single host, so the socket
+ * never listens on any other interface. Only supported on POSIX systems,
+ * elsewhere the socket never opens.
+ */
+class UdpSocket {
+  using SELF = UdpSocket;
+
+  int fd;
+
+ public:
+  /**
+   * @brief Constructor for a socket, bound to a loopback port.
+   *
+   * @param port the port, or 0 to have one picked
+   *
+   * Failures are logged, and leave the socket closed.
+   */
+  explicit UdpSocket(uint16_t port = 0);
+  UdpSocket(const UdpSocket &) = delete;
+  UdpSocket &operator=(const UdpSocket &) = delete;
+
+  /**
+   * @brief Check whether or not the socket is open.
+   *
+   * @return true if open, otherwise false
+   */
+  bool isOpen() const;
+  /**
+   * @brief Get the port the socket is bound to.
+   *
+   * @return the port, or 0 if closed
+   */
+  uint16_t port() const;
+
+  /**
+   * @brief Send a datagram.
+   *
+   * @param to the address sent to
+   * @param data the datagram's bytes
+   * @param size amount of bytes
+   *
+   * @return whether or not the datagram was sent whole
+   */
+  bool send(const Address &to, const unsigned char *data, size_t size);
+  /**
+   * @brief Wait for a datagram and receive it.
+   *
+   * @param data buffer the datagram is received into
+   * @param capacity bytes the buffer holds, beyond which the datagram is cut
+   * @param from set to the address the datagram came from
+   * @param timeoutMicros longest wait, in microseconds, 0 not waiting at all
+   *
+   * @return size of the datagram, or -1 if none came in time
+   */
+  long receive(unsigned char *data, size_t capacity, Address &from,
+               long timeoutMicros);
+
+  /**
+   * @brief Destructor for the socket, closing it.
+   */
+  ~UdpSocket();
+};
+
+};  // namespace net
+
+#endif
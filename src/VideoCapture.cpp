@@ -0,0 +1,197 @@
+/**
+ * @file VideoCapture.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Implements the class for capturing frames to a raw video file.
+ */
+#include "VideoCapture.h"
+
+#include <cstring>
+
+#include "Logger.h"
+#include "Tracer.h"
+
+using SELF = VideoCapture;
+
+VideoCapture::VideoCapture(const char *_path, int _width, int _height,
+                           int fps)
+    : path{_path},
+      width{_width},
+      height{_height},
+      frameSize{(size_t)_width * _height * 4},
+      y4m{false},
+      file{fopen(_path, "wb")},
+      next{0},
+      reading{0},
+      head{0},
+      queued{0},
+      stopping{false},
+      captured{0},
+      costSum{0.0},
+      costMax{0.0},
+      written{0} {
+  if (file == NULL) {
+    logger::log(logger::level::ERROR, "Couldn't open %s for writing", path);
+    return;
+  }
+  size_t length = strlen(path);
+  y4m = length >= 4 && strcmp(path + length - 4, ".y4m") == 0;
+  if (y4m)
+    fprintf(file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", width, height,
+            fps);
+
+  glGenBuffers(videoConstants::pbo_count, PBOs);
+  for (GLuint PBO : PBOs) {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, PBO);
+    glBufferData(GL_PIXEL_PACK_BUFFER, frameSize, NULL, GL_STREAM_READ);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  for (auto &frame : frames) frame.resize(frameSize);
+  writer = std::thread(&VideoCapture::write, this);
+}
+
+/**
+ * Reads finish in the order they were queued, so collecting stops at the
+ * first one still in progress. A frame read while the writer thread's queue
+ * is full is dropped.
+ */
+void VideoCapture::collect(bool wait) {
+  while (reading > 0) {
+    int slot = (next - reading + videoConstants::pbo_count) %
+               videoConstants::pbo_count;
+    GLenum state = glClientWaitSync(fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT,
+                                    wait ? GL_TIMEOUT_IGNORED : 0);
+    if (state == GL_TIMEOUT_EXPIRED) return;
+    glDeleteSync(fences[slot]);
+    reading--;
+
+    int index;
+    {
+      std::lock_guard<std::mutex> guard{lock};
+      if (queued == videoConstants::queued_frames) continue;
+      index = (head + queued) % videoConstants::queued_frames;
+    }
+    // the writer thread leaves the slot alone until it is queued
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, PBOs[slot]);
+    void *pixels =
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameSize, GL_MAP_READ_BIT);
+    if (pixels != NULL) {
+      memcpy(frames[index].data(), pixels, frameSize);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (pixels == NULL) continue;
+
+    {
+      std::lock_guard<std::mutex> guard{lock};
+      queued++;
+    }
+    wake.notify_one();
+  }
+}
+
+/**
+ * When every buffer is still being read into, the GPU is too far behind and
+ * the frame is dropped rather than waited for.
+ */
+SELF &VideoCapture::grab(GLuint framebuffer) {
+  if (file == NULL) return *this;
+  clock::time_point start = clock::now();
+  captured++;
+
+  collect(false);
+  if (reading < videoConstants::pbo_count) {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, PBOs[next]);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (void *)0);
+    fences[next] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    next = (next + 1) % videoConstants::pbo_count;
+    reading++;
+  }
+
+  std::chrono::duration<double, std::milli> cost = clock::now() - start;
+  costSum += cost.count();
+  if (cost.count() > costMax) costMax = cost.count();
+  return *this;
+}
+
+/**
+ * Queued frames are still written out after being asked to stop.
+ */
+void VideoCapture::write() {
+  tracer::nameThread("video");
+  std::vector<unsigned char> planes((size_t)width * height * 3);
+  bool failed = false;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> guard{lock};
+      wake.wait(guard, [this] { return queued > 0 || stopping; });
+      if (queued == 0) return;
+    }
+
+    if (!failed) {
+      tracer::Scope trace{"VIDEO WRITE"};
+      if (writeFrame(frames[head], planes))
+        written++;
+      else {
+        logger::log(logger::level::ERROR, "Couldn't write to %s", path);
+        failed = true;
+      }
+    }
+
+    std::lock_guard<std::mutex> guard{lock};
+    head = (head + 1) % videoConstants::queued_frames;
+    queued--;
+  }
+}
+
+/**
+ * Y4M frames use BT.601 limited range, in fixed point.
+ */
+bool VideoCapture::writeFrame(const std::vector<unsigned char> &frame,
+                              std::vector<unsigned char> &planes) {
+  const size_t plane = (size_t)width * height;
+  for (int y = 0; y < height; y++) {
+    const unsigned char *source = &frame[(size_t)(height - 1 - y) * width * 4];
+    for (int x = 0; x < width; x++) {
+      int r = source[x * 4], g = source[x * 4 + 1], b = source[x * 4 + 2];
+      size_t pixel = (size_t)y * width + x;
+      if (!y4m) {
+        planes[pixel * 3] = r;
+        planes[pixel * 3 + 1] = g;
+        planes[pixel * 3 + 2] = b;
+        continue;
+      }
+      planes[pixel] = ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16;
+      planes[plane + pixel] = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+      planes[2 * plane + pixel] =
+          ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+    }
+  }
+  if (y4m && fputs("FRAME\n", file) == EOF) return false;
+  return fwrite(planes.data(), 1, plane * 3, file) == plane * 3;
+}
+
+VideoCapture::~VideoCapture() {
+  if (file == NULL) return;
+  collect(true);
+  {
+    std::lock_guard<std::mutex> guard{lock};
+    stopping = true;
+  }
+  wake.notify_one();
+  writer.join();
+  fclose(file);
+  glDeleteBuffers(videoConstants::pbo_count, PBOs);
+
+  logger::log(logger::level::INFO,
+              "Video %s: %lu frames written, %lu dropped, capture cost %.3f "
+              "ms avg, %.3f ms max per frame",
+              path, written, captured - written,
+              captured > 0 ? costSum / captured : 0.0, costMax);
+}
@@ -0,0 +1,125 @@
+/**
+ * @file VideoCapture.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Declares the class for capturing frames to a raw video file.
+ */
+#ifndef VIDEO_CAPTURE_H
+#define VIDEO_CAPTURE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Include/glad/glad.h"
+#include "constants.h"
+
+/**
+ * @brief Defines the methods for streaming every rendered frame to disk
+ * without stalling the render thread.
+ *
+ * Each frame is read as RGBA, the format drivers copy without converting,
+ * into the next of videoConstants::pbo_count pixel buffer objects, so
+ * glReadPixels only queues a copy, and a fence marks when the copy is done.
+ * Frames are mapped once their fences have signaled, copied into a queue of
+ * buffers reserved up front and handed to a writer thread, which converts
+ * and writes them. When the GPU or the disk falls behind, frames are dropped
+ * and counted instead of being waited for.
+ *
+ * Files ending in `.y4m` are written as YUV4MPEG2 with 4:4:4 chroma, and any
+ * other file as raw RGB24 rows, starting from the top.
+ */
+class VideoCapture {
+  using SELF = VideoCapture;
+  using clock = std::chrono::steady_clock;
+
+  const char *path;
+  int width, height;
+  size_t frameSize;
+  bool y4m;
+  FILE *file;
+
+  GLuint PBOs[videoConstants::pbo_count];
+  GLsync fences[videoConstants::pbo_count];
+  // next buffer to read into, and how many before it are still being read
+  int next, reading;
+
+  // frames handed to the writer thread, in a ring of queued_frames
+  std::vector<unsigned char> frames[videoConstants::queued_frames];
+  int head, queued;
+  bool stopping;
+  std::mutex lock;
+  std::condition_variable wake;
+  std::thread writer;
+
+  // counted on the render thread
+  unsigned long captured;
+  double costSum, costMax;
+  // counted on the writer thread, and read once it has stopped
+  unsigned long written;
+
+  /**
+   * @brief Hand the frames whose reads are done to the writer thread.
+   *
+   * @param wait whether or not to wait for reads still in progress
+   */
+  void collect(bool wait);
+  /**
+   * @brief Write queued frames out until stopped, on the writer thread.
+   */
+  void write();
+  /**
+   * @brief Convert a frame and write it out.
+   *
+   * @param frame RGBA rows starting from the bottom, as OpenGL reads them
+   * @param planes scratch buffer for the converted frame
+   *
+   * @return whether or not the frame was written
+   */
+  bool writeFrame(const std::vector<unsigned char> &frame,
+                  std::vector<unsigned char> &planes);
+
+ public:
+  /**
+   * @brief Constructor for the VideoCapture, opening the file and starting
+   * the writer thread.
+   *
+   * @param _path the video file's path
+   * @param _width frame width in pixels
+   * @param _height frame height in pixels
+   * @param fps frame rate written to Y4M headers
+   */
+  VideoCapture(const char *_path, int _width, int _height, int fps);
+  VideoCapture(const VideoCapture &) = delete;
+  VideoCapture &operator=(const VideoCapture &) = delete;
+
+  /**
+   * @brief Check whether or not the file could be opened.
+   *
+   * @return true if it is the case, otherwise false
+   */
+  bool isOpen() const { return file != NULL; }
+
+  /**
+   * @brief Capture the frame just rendered, without waiting on the GPU.
+   *
+   * @param framebuffer the framebuffer holding the frame, 0 for the window's
+   *
+   * @return reference to the object
+   */
+  SELF &grab(GLuint framebuffer);
+
+  /**
+   * @brief Destructor for the VideoCapture, waiting for every captured frame
+   * to be written out, then logging how many were written and dropped and
+   * what capturing cost the render thread per frame.
+   */
+  ~VideoCapture();
+};
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file Benchmark.h
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Defines and implements the microbenchmark harness.
+ */
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Relates to classes and functions concerning benchmarking.
+ */
+namespace bench {
+
+/**
+ * @brief Prevent the compiler from optimizing a value away.
+ *
+ * @param value the value to be kept
+ */
+template <typename T>
+inline void keep(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief The summary of a benchmark's repetitions, in nanoseconds per
+ * operation.
+ */
+struct Result {
+  std::string name, params;
+  long ops;
+  int reps;
+  double min, median, p90, p99, max;
+  // memory held by the benchmarked objects, if measured
+  size_t bytes;
+};
+
+/**
+ * @brief Defines the methods for running benchmarks and reporting their
+ * results.
+ *
+ * Each benchmark is run for a few untimed warmup repetitions, then timed over
+ * the given amount of repetitions. Every repetition performs a fixed amount of
+ * operations, and the time per operation is summarized with its median and
+ * percentiles across repetitions.
+ */
+class Harness {
+  using SELF = Harness;
+
+  int warmup, reps;
+  std::string filter;
+  std::vector<Result> results;
+  bool lastRan;
+
+  /**
+   * @brief Get a percentile of sorted samples, by nearest rank.
+   *
+   * @param sorted samples sorted in ascending order
+   * @param p the percentile, ranging from 0.0 to 1.0
+   *
+   * @return the sample at the percentile
+   */
+  static double percentile(const std::vector<double> &sorted, double p) {
+    size_t rank = (size_t)std::ceil(p * sorted.size());
+    return sorted[rank == 0 ? 0 : rank - 1];
+  }
+
+ public:
+  /**
+   * @brief Constructor for the Harness.
+   *
+   * @param _warmup amount of untimed repetitions before timing
+   * @param _reps amount of timed repetitions
+   * @param _filter only benchmarks whose name or parameters contain it are run,
+   * or every benchmark if empty
+   */
+  Harness(int _warmup, int _reps, const std::string &_filter)
+      : warmup{_warmup},
+        reps{_reps < 1 ? 1 : _reps},
+        filter{_filter},
+        lastRan{false} {}
+
+  /**
+   * @brief Run a benchmark.
+   *
+   * @param name name of the benchmark
+   * @param params description of the benchmark's parameters
+   * @param ops amount of operations performed by each call to body
+   * @param setup called before each repetition, untimed
+   * @param body called once per repetition, timed
+   *
+   * @return reference to the object
+   */
+  template <typename Setup, typename Body>
+  SELF &run(const std::string &name, const std::string &params, long ops,
+            Setup setup, Body body) {
+    lastRan = filter.empty() || name.find(filter) != std::string::npos ||
+              params.find(filter) != std::string::npos;
+    if (!lastRan) return *this;
+
+    std::vector<double> samples;
+    for (int i = -warmup; i < reps; i++) {
+      setup();
+      auto start = std::chrono::steady_clock::now();
+      body();
+      std::chrono::duration<double, std::nano> elapsed =
+          std::chrono::steady_clock::now() - start;
+      if (i >= 0) samples.push_back(elapsed.count() / ops);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result result{name,
+                  params,
+                  ops,
+                  reps,
+                  samples.front(),
+                  percentile(samples, 0.5),
+                  percentile(samples, 0.9),
+                  percentile(samples, 0.99),
+                  samples.back(),
+                  0};
+    printf("%-22s %-24s %12.1f %12.1f %12.1f ns/op\n", name.c_str(),
+           params.c_str(), result.median, result.p90, result.p99);
+    fflush(stdout);
+    results.push_back(result);
+    return *this;
+  }
+
+  /**
+   * @brief Run a benchmark without per-repetition setup.
+   *
+   * @param name name of the benchmark
+   * @param params description of the benchmark's parameters
+   * @param ops amount of operations performed by each call to body
+   * @param body called once per repetition, timed
+   *
+   * @return reference to the object
+   */
+  template <typename Body>
+  SELF &run(const std::string &name, const std::string &params, long ops,
+            Body body) {
+    return run(name, params, ops, [] {}, body);
+  }
+
+  /**
+   * @brief Attach the memory held by the benchmarked objects to the latest
+   * benchmark, unless it was filtered out.
+   *
+   * @param bytes the amount of memory, in bytes
+   *
+   * @return reference to the object
+   */
+  SELF &memory(size_t bytes) {
+    if (!lastRan) return *this;
+    results.back().bytes = bytes;
+    printf("%-22s %-24s %12zu bytes\n", "", "", bytes);
+    return *this;
+  }
+
+  /**
+   * @brief Print the header for the results table.
+   *
+   * @return reference to the object
+   */
+  SELF &printHeader() {
+    printf("%-22s %-24s %12s %12s %12s\n", "benchmark", "params", "median",
+           "p90", "p99");
+    return *this;
+  }
+
+  /**
+   * @brief Write every result to a JSON file.
+   *
+   * @param path path of the file
+   *
+   * @return whether or not the file was written
+   */
+  bool writeJSON(const char *path) const {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) return false;
+
+    fprintf(file, "{\"unit\":\"ns/op\",\"warmup\":%d,\"benchmarks\":[", warmup);
+    for (size_t i = 0; i < results.size(); i++) {
+      const Result &r = results[i];
+      fprintf(file,
+              "%s\n{\"name\":\"%s\",\"params\":\"%s\",\"ops\":%ld,\"reps\":%d,"
+              "\"min\":%.3f,\"median\":%.3f,\"p90\":%.3f,\"p99\":%.3f,"
+              "\"max\":%.3f,\"bytes\":%zu}",
+              i == 0 ? "" : ",", r.name.c_str(), r.params.c_str(), r.ops,
+              r.reps, r.min, r.median, r.p90, r.p99, r.max, r.bytes);
+    }
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    return true;
+  }
+};
+
+};  // namespace bench
+
+#endif
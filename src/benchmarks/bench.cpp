@@ -0,0 +1,504 @@
+/**
+ * @file bench.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Microbenchmark suite entrypoint.
+ *
+ * Accepted arguments:
+ * - `--warmup <n>` untimed repetitions per benchmark, 3 by default
+ * - `--reps <n>` timed repetitions per benchmark, 15 by default
+ * - `--filter <text>` only run benchmarks whose name or parameters contain it
+ * - `--max-length <n>` longest Snake in the length sweeps, 1000000 by default
+ * - `--json <path>` also write the results as JSON to path
+ * - `--headless <osmesa|egl>` also run the draw benchmarks, through a hidden
+ *   OSMesa or EGL context, which are skipped otherwise
+ */
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Assets.h"
+#include "../AudioHandler.h"
+#include "../Board.h"
+#include "../ChunkGrid.h"
+#include "../FontRenderer.h"
+#include "../Framebuffer.h"
+#include "../MeshRegistry.h"
+#include "../PartInstances.h"
+#include "../Point.h"
+#include "../Score.h"
+#include "../Simulation.h"
+#include "../Snake.h"
+#include "../camera.h"
+#include "../constants.h"
+#include "../gameHandler.h"
+#include "../process_input.h"
+#include "../shader.h"
+#include "Benchmark.h"
+
+// window size read by the game's window handling, as the game defines it
+int window_width = settingConstants::window_width;
+int window_height = settingConstants::window_height;
+
+namespace {
+
+const float scale = modelConstants::scale_factor;
+
+/**
+ * @brief Create a straight Snake on a plane wide enough for it to never wrap
+ * onto itself, so collision checks always scan every part.
+ *
+ * @param length amount of parts
+ *
+ * @return the Snake, with room reserved for its parts
+ */
+std::unique_ptr<snake::Snake> straightSnake(long length) {
+  float border = (length + 1) * scale;
+  return std::unique_ptr<snake::Snake>(new snake::Snake{
+      glm::vec3(0.0f, 0.0f, 0.0f), (int)length, scale, scale, border, border,
+      snake::movement::DOWN, (size_t)length});
+}
+
+/**
+ * @brief Create a Snake lying along a single row of a board, as the game
+ * places it.
+ *
+ * @param length amount of parts, at most the board's width
+ * @param board the board the Snake is on
+ *
+ * @return the Snake
+ */
+std::unique_ptr<snake::Snake> rowSnake(long length, const Board &board) {
+  return std::unique_ptr<snake::Snake>(new snake::Snake{
+      board.center(), (int)length, scale, scale, board.borderX(),
+      board.borderZ(), snake::movement::DOWN, board.reservedParts(length)});
+}
+
+/**
+ * @brief Create a Snake folded into a zigzag, turning after every run of
+ * parts, on a plane wide enough for it to never wrap.
+ *
+ * @param length amount of parts
+ * @param run amount of parts between turns
+ *
+ * @return the Snake
+ */
+std::unique_ptr<snake::Snake> zigzagSnake(long length, long run) {
+  auto snek = straightSnake(length);
+  for (long i = 0; i < length; i++) {
+    long phase = i % (2 * (run + 1));
+    if (phase == run || phase == 2 * run + 1)
+      snek->updateDirection(snake::movement::LEFT);
+    else
+      snek->updateDirection(phase < run ? snake::movement::DOWN
+                                        : snake::movement::UP);
+    snek->move();
+  }
+  return snek;
+}
+
+std::string param(const char *name, long value) {
+  return std::string(name) + "=" + std::to_string(value);
+}
+
+void benchSnake(bench::Harness &harness, long maxLength) {
+  for (long length : {3L, 100L, 10000L, 1000000L}) {
+    if (length > maxLength) break;
+    auto snek = straightSnake(length);
+    glm::vec3 away{0.0f, 0.0f, 5.0f};
+    long moves = std::max(1L, 4000000L / length);
+    long checks = std::max(1L, 20000000L / length);
+
+    harness.run("snake_move", param("length", length), moves, [&] {
+      for (long i = 0; i < moves; i++) snek->move();
+    });
+    harness.run("snake_self_collision", param("length", length), checks, [&] {
+      for (long i = 0; i < checks; i++) bench::keep(snek->selfCollision());
+    });
+    harness.run("snake_point_collision", param("length", length), checks,
+                [&] {
+                  for (long i = 0; i < checks; i++)
+                    bench::keep(snek->pointCollisionAll(away));
+                });
+  }
+
+  const long adds = 100000;
+  std::unique_ptr<snake::Snake> snek;
+  harness.run(
+      "snake_add_part", "grow=100000", adds, [&] { snek = straightSnake(3); },
+      [&] {
+        for (long i = 0; i < adds; i++) snek->addPart();
+      });
+  harness.run(
+      "snake_add_part_reserved", "grow=100000", adds,
+      [&] {
+        snek.reset(new snake::Snake{glm::vec3(0.0f, 0.0f, 0.0f), 3, scale,
+                                    scale, (adds + 4) * scale,
+                                    (adds + 4) * scale, snake::movement::DOWN,
+                                    (size_t)adds + 3});
+      },
+      [&] {
+        for (long i = 0; i < adds; i++) snek->addPart();
+      });
+}
+
+/**
+ * Each operation builds every model matrix a frame of the Snake uploads,
+ * either one per part or one per straight run. Folding a Snake takes as many
+ * moves as it has parts, so the lengths stop short of the other sweeps.
+ */
+void benchSnakeModels(bench::Harness &harness, long maxLength) {
+  for (long length : {100L, 1000L, 10000L}) {
+    if (length > maxLength) break;
+    for (long run : {4L, 64L}) {
+      auto snek = zigzagSnake(length, run);
+      const std::vector<snake::SnakePart> &parts = snek->getParts();
+      std::vector<snake::Segment> segments;
+      snek->getSegments().copyTo(segments);
+      const std::string params = param("length", length) + "," +
+                                 param("run", run) + "," +
+                                 param("segments", segments.size());
+      long frames = std::max(1L, 2000000L / length);
+
+      harness.run("snake_models_parts", params, frames, [&] {
+        for (long i = 0; i < frames; i++)
+          for (const auto &part : parts) bench::keep(part.model());
+      });
+      harness.run("snake_models_merged", params, frames, [&] {
+        for (long i = 0; i < frames; i++) {
+          snek->getSegments().copyTo(segments);
+          for (const auto &segment : segments) bench::keep(segment.model());
+        }
+      });
+    }
+  }
+}
+
+/**
+ * @brief Set up the view and projection of a board just holding a Snake's
+ * parts, as the game sets them up, moved over to the parts so that they
+ * stand where the board's cells would.
+ *
+ * @param shaderProgram main model shader program, in use
+ * @param parts the Snake's parts
+ */
+void viewSnake(Shader &shaderProgram,
+               const std::vector<snake::SnakePart> &parts) {
+  glm::vec3 low = parts.front().getTrans(), high = low;
+  for (const auto &part : parts) {
+    low = glm::min(low, part.getTrans());
+    high = glm::max(high, part.getTrans());
+  }
+  Board board{(int)std::lround((high.x - low.x) / scale) + 1,
+              (int)std::lround((high.z - low.z) / scale) + 1};
+  Camera camera{board.cameraPosition(), glm::vec3(0.0f, 1.0f, 0.0f), -45.17f,
+                -38.32f};
+  glm::vec3 center = (low + high) * 0.5f;
+  shaderProgram.setm4fv(
+      "view", camera.lookAt() * glm::translate(glm::mat4(1.0f),
+                                               glm::vec3(-center.x, 0.0f,
+                                                         -center.z)));
+  shaderProgram.setm4fv(
+      "projection", glm::perspective(glm::radians(settingConstants::zoom),
+                                     (float)window_width / (float)window_height,
+                                     0.1f * board.viewScale(),
+                                     100.0f * board.viewScale()));
+}
+
+/**
+ * Each operation is one ticked frame of the Snake drawn into an offscreen
+ * framebuffer, through the game's camera framing the whole Snake, so nothing
+ * is culled. The parts are either uploaded as instances and drawn with a
+ * single call, drawn each on its own with its model matrix, or drawn as one
+ * box per straight run. The frame is finished before the next one starts, so
+ * the time spent by the GPU and the driver is included along with the
+ * submission.
+ */
+void benchSnakeDraw(bench::Harness &harness, long maxLength,
+                    int headlessAPI) {
+  GLFWwindow *window = initializeWindow(window_width, window_height,
+                                        "Snake3D bench", 0, headlessAPI);
+  if (window == NULL) {
+    fprintf(stderr, "Couldn't create a headless context, skipping draws\n");
+    glfwTerminate();
+    return;
+  }
+
+  {
+    assets::Blob vertex, fragment;
+    if (!assets::read("./shaders/snake/shader.vs", vertex) ||
+        !assets::read("./shaders/snake/shader.fs", fragment)) {
+      fprintf(stderr, "Couldn't read the Snake shader, skipping draws\n");
+      glfwTerminate();
+      return;
+    }
+    Shader shaderProgram{vertex, fragment};
+    Framebuffer offscreen{window_width, window_height};
+    MeshRegistry meshes;
+    Mesh cubeMesh = meshes.add(
+        modelConstants::vertices_cube, sizeof(modelConstants::vertices_cube),
+        modelConstants::indices_cube, sizeof(modelConstants::indices_cube),
+        {3});
+    meshes.upload();
+    Mesh snakeMesh = meshes.separate(cubeMesh);
+    StreamBuffer stream;
+    ChunkGrid chunks{Board{}};
+
+    offscreen.bind();
+    shaderProgram.use();
+    shaderProgram.setv4fv("ourColor", modelConstants::colorSnake);
+    const GLint modelLocation = shaderProgram.location("model");
+
+    for (long length : {100L, 1000L, 10000L}) {
+      if (length > maxLength) break;
+      for (long run : {4L, 64L}) {
+        auto snek = zigzagSnake(length, run);
+        const std::vector<snake::SnakePart> &parts = snek->getParts();
+        std::vector<snake::PartMotion> motions;
+        for (const auto &part : parts)
+          motions.push_back(
+              snake::PartMotion{part.getTrans(), part.getTrans()});
+        std::vector<snake::Segment> segments;
+        snek->getSegments().copyTo(segments);
+        const std::string params = param("length", length) + "," +
+                                   param("run", run) + "," +
+                                   param("segments", segments.size());
+        long frames = std::max(1L, 20000L / length);
+
+        viewSnake(shaderProgram, parts);
+        PartInstances instances{(size_t)length, &stream};
+        snakeMesh.bind();
+        instances.attach();
+
+        harness.run("snake_draw_parts", params, frames, [&] {
+          for (long i = 0; i < frames; i++) {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            snakeMesh.bind();
+            for (const auto &part : parts)
+              snakeMesh.draw(part.model(), modelLocation);
+            glFinish();
+          }
+        });
+        harness.run("snake_draw_instanced", params, frames, [&] {
+          for (long i = 0; i < frames; i++) {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            snakeMesh.bind();
+            instances.upload(motions, chunks);
+            instances.draw(snakeMesh, shaderProgram, 1.0f);
+            stream.endFrame();
+            glFinish();
+          }
+        });
+        harness.run("snake_draw_merged", params, frames, [&] {
+          for (long i = 0; i < frames; i++) {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            snakeMesh.bind();
+            snek->getSegments().copyTo(segments);
+            for (const auto &segment : segments)
+              snakeMesh.draw(segment.model(), modelLocation);
+            glFinish();
+          }
+        });
+      }
+    }
+  }
+  glfwTerminate();
+}
+
+/**
+ * The Point is put on the Snake's head before every relocation, as when it
+ * is eaten, so each operation is one full food respawn.
+ */
+void benchSpawn(bench::Harness &harness) {
+  for (int side : {20, 64, 256, 1024}) {
+    for (long length : {3L, (long)side}) {
+      Board board{side, side};
+      auto snek = rowSnake(length, board);
+      Point point{snek->getHeadTrans(), scale};
+      const long spawns = 2000;
+      harness.run("food_spawn",
+                  param("board", side) + "," + param("length", length), spawns,
+                  [&] {
+                    for (long i = 0; i < spawns; i++) {
+                      point = Point{snek->getHeadTrans(), scale};
+                      relocatePoint(*snek, point, board);
+                    }
+                    bench::keep(point.getTrans());
+                  });
+    }
+  }
+}
+
+/**
+ * Each operation is one tick of a Simulation set up as the game sets it up,
+ * so the memory reserved for the Snake and its snapshots is included.
+ */
+void benchBoard(bench::Harness &harness) {
+  const long length = 16, ticks = 10000;
+
+  for (int side : {20, 256, 1024, 4096}) {
+    Board board{side, side};
+    std::unique_ptr<snake::Snake> snek;
+    std::unique_ptr<Point> point;
+    std::unique_ptr<Score> score;
+    std::unique_ptr<Simulation> simulation;
+    size_t bytes = 0;
+
+    harness.run(
+        "board_tick", param("board", side), ticks,
+        [&] {
+          simulation.reset();
+          snek = rowSnake(length, board);
+          point.reset(new Point{board.cell(0, 0), scale});
+          score.reset(new Score);
+          simulation.reset(new Simulation{*snek, *point, *score, board,
+                                          nullptr, nullptr,
+                                          board.reservedParts(length)});
+          const Snapshot &view = simulation->snapshot();
+          bytes = snek->getParts().capacity() * sizeof(snake::SnakePart) +
+                  3 * view.motions.capacity() * sizeof(snake::PartMotion) +
+                  3 * view.segments.capacity() * sizeof(snake::Segment);
+        },
+        [&] {
+          for (long i = 0; i < ticks; i++)
+            bench::keep(simulation->step(snake::movement::DOWN));
+        });
+    harness.memory(bytes);
+  }
+}
+
+void benchScore(bench::Harness &harness) {
+  Score score;
+  const long updates = 1000000;
+  harness.run("score_update", "", updates, [&] {
+    for (long i = 0; i < updates; i++) bench::keep(score.updateScore());
+  });
+}
+
+void benchText(bench::Harness &harness) {
+  GlyphLayout glyphs{fontConstants::bitmap_width,
+                     fontConstants::bitmap_height,
+                     fontConstants::font_char_width,
+                     fontConstants::font_char_height,
+                     fontConstants::number_seq_start,
+                     fontConstants::letter_seq_start};
+  const std::string words = "SNAKE3D SCORE 0123456789 PRESS ENTER TO START ";
+
+  for (long chars : {8L, 64L, 512L}) {
+    std::string text;
+    for (long i = 0; i < chars; i++)
+      text += (i % 32 == 31) ? '\n' : words[i % words.size()];
+    const long layouts = std::max(1L, 200000L / chars);
+    float sink = 0.0f;
+
+    harness.run("text_layout", param("chars", chars), layouts, [&] {
+      for (long i = 0; i < layouts; i++)
+        glyphs.layout(text.c_str(), 0.25f, -2.8f, -2.2f, 0.3f, 0.5f,
+                      [&](const glm::mat4 &model, const glm::vec2 &texPos) {
+                        sink += model[3][0] + texPos.x;
+                      });
+      bench::keep(sink);
+    });
+  }
+}
+
+/**
+ * Each operation is one period of 1024 frames, a common ALSA period size.
+ */
+void benchAudio(bench::Harness &harness) {
+  const unsigned long frames = 1024;
+  const long periods = 2000;
+  std::vector<int16_t> in(frames * 2), out(frames * 2);
+  for (size_t i = 0; i < in.size(); i++) in[i] = (int16_t)(i * 37);
+
+  harness.run("audio_scale", "stereo", periods, [&] {
+    for (long i = 0; i < periods; i++) {
+      scalePeriod(in.data(), frames * 2, 0.999);
+      bench::keep(in[0]);
+    }
+  });
+  for (int channels : {1, 2}) {
+    harness.run("audio_mix_panned", param("channels", channels), periods, [&] {
+      for (long i = 0; i < periods; i++) {
+        mixPeriod(in.data(), out.data(), frames, channels, 0.7f, 0.5f);
+        bench::keep(out[0]);
+      }
+    });
+  }
+
+  const long voices = 1000000;
+  glm::vec3 listener{1.6f, 0.5f, 1.6f}, right{0.7f, 0.0f, -0.7f};
+  harness.run("audio_positional_gains", "", voices, [&] {
+    float left, rightGain;
+    for (long i = 0; i < voices; i++) {
+      positionalGains(glm::vec3(0.1f * (i % 20), 0.0f, 0.0f), listener, right,
+                      0.2, left, rightGain);
+      bench::keep(left);
+      bench::keep(rightGain);
+    }
+  });
+}
+
+};  // namespace
+
+int main(int argc, char *argv[]) {
+  int warmup = 3, reps = 15;
+  long maxLength = 1000000;
+  const char *filter = "";
+  const char *json = NULL;
+  int headlessAPI = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (i + 1 >= argc) {
+      fprintf(stderr, "Missing value for %s\n", argv[i]);
+      return 1;
+    }
+    if (strcmp(argv[i], "--warmup") == 0)
+      warmup = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--reps") == 0)
+      reps = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--filter") == 0)
+      filter = argv[++i];
+    else if (strcmp(argv[i], "--max-length") == 0)
+      maxLength = atol(argv[++i]);
+    else if (strcmp(argv[i], "--json") == 0)
+      json = argv[++i];
+    else if (strcmp(argv[i], "--headless") == 0) {
+      i++;
+      if (strcmp(argv[i], "egl") == 0)
+        headlessAPI = GLFW_EGL_CONTEXT_API;
+      else if (strcmp(argv[i], "osmesa") == 0)
+        headlessAPI = GLFW_OSMESA_CONTEXT_API;
+      else {
+        fprintf(stderr, "Unknown headless context %s, use osmesa or egl\n",
+                argv[i]);
+        return 1;
+      }
+    } else {
+      fprintf(stderr, "Unknown argument %s\n", argv[i]);
+      return 1;
+    }
+  }
+
+  bench::Harness harness{warmup, reps, filter};
+  harness.printHeader();
+  benchSnake(harness, maxLength);
+  benchSnakeModels(harness, maxLength);
+  if (headlessAPI != 0) benchSnakeDraw(harness, maxLength, headlessAPI);
+  benchSpawn(harness);
+  benchBoard(harness);
+  benchScore(harness);
+  benchText(harness);
+  benchAudio(harness);
+
+  if (json != NULL && !harness.writeJSON(json)) {
+    fprintf(stderr, "Couldn't write %s\n", json);
+    return 1;
+  }
+  return 0;
+}
@@ -28,6 +28,7 @@ class Camera {
   glm::vec3 front;
   glm::vec3 up;
   glm::vec3 worldup;
+  glm::mat4 projection;
   float yaw;
   float pitch;
 
@@ -36,7 +37,7 @@ class Camera {
    *
    * @return reference to the object
    */
-  SELF& updateUp() {
+  SELF &updateUp() {
     auto directionRight = glm::normalize(glm::cross(worldup, front));
     up = glm::normalize(glm::cross(front, directionRight));
 
@@ -49,7 +50,7 @@ class Camera {
    *
    * @return reference to the object
    */
-  SELF& updateDirection() {
+  SELF &updateDirection() {
     glm::vec3 frontv;
     float cospitch = (float)cos(glm::radians(pitch));
     frontv.x = sin(glm::radians(yaw)) * cospitch;
@@ -69,12 +70,13 @@ class Camera {
    * @param yaw starting yaw rotation value
    * @param pitch starting pitch rotation value
    */
-  Camera(const glm::vec3& position = glm::vec3(0.0f, 0.0f, 0.0f),
-         const glm::vec3& up = glm::vec3(0.0f, 1.0f, 0.0f), float yaw = YAW,
+  Camera(const glm::vec3 &position = glm::vec3(0.0f, 0.0f, 0.0f),
+         const glm::vec3 &up = glm::vec3(0.0f, 1.0f, 0.0f), float yaw = YAW,
          float pitch = PITCH)
       : position{position},
         front{glm::vec3(0.0f, 0.0f, -1.0f)},
         worldup{up},
+        projection{glm::mat4(1.0f)},
         yaw{yaw},
         pitch{pitch} {
     updateDirection();
@@ -86,6 +88,40 @@ class Camera {
    * @return view matrix
    */
   glm::mat4 lookAt() { return glm::lookAt(position, position + front, up); }
+
+  /**
+   * @brief Sets the Camera's projection matrix.
+   *
+   * @param _projection projection matrix
+   *
+   * @return reference to the object
+   */
+  SELF &setProjection(const glm::mat4 &_projection) {
+    projection = _projection;
+    return *this;
+  }
+
+  /**
+   * @brief Returns the Camera's projection matrix.
+   *
+   * @return projection matrix
+   */
+  const glm::mat4 &getProjection() const { return projection; }
+
+  /**
+   * @brief Returns the Camera's position.
+   *
+   * @return position 3D vector
+   */
+  glm::vec3 getPosition() const { return position; }
+
+  /**
+   * @brief Returns the Camera's right direction, perpendicular to both its
+   * front and up vectors.
+   *
+   * @return normalized right 3D vector
+   */
+  glm::vec3 getRight() const { return glm::normalize(glm::cross(front, up)); }
 };
 
 #endif
@@ -27,6 +27,65 @@ const double delay = 0.5f;
 
 };  // namespace settingConstants
 
+/**
+ * @brief Constants related to frame pacing.
+ *
+ * @see FrameLimiter
+ */
+namespace frameConstants {
+
+// vertical blanks to wait for between buffer swaps, 0 disables vsync
+const int swap_interval = 1;
+// time before a deadline spent spinning instead of sleeping
+const long spin_margin_us = 1500;
+// seconds between blinks of the menu screens' prompts
+const double blink_interval = 1.0;
+// largest difference allowed for any channel when comparing with an image
+const int golden_tolerance = 2;
+
+};  // namespace frameConstants
+
+/**
+ * @brief Constants related to the simulation's tick rate.
+ *
+ * @see Simulation
+ */
+namespace tickConstants {
+
+// fastest tick rate allowed, in ticks per second
+const double max_rate = 1000.0;
+// factor the tick rate grows by with every point scored, when ramping up
+const double ramp_factor = 1.15;
+// late ticks run back to back to catch up, before the rest are dropped
+const int max_catch_up = 4;
+
+};  // namespace tickConstants
+
+/**
+ * @brief Constants related to the board's geometry.
+ *
+ * @see Board
+ */
+namespace boardConstants {
+
+// amount of cells along each side of the default board
+const int default_side = 20;
+// amount of cells along each side of the smallest board allowed, which fits
+// the default Snake with room left for the Point
+const int min_side = 3;
+// amount of cells along each side of the largest board allowed
+const int max_side = 4096;
+// camera offset from the plane's center, for a board 2 units across
+const glm::vec3 camera_offset = glm::vec3(1.6f, 1.5f, 1.6f);
+// most Snake parts to reserve memory for up front
+const long max_reserved_parts = 1 << 16;
+// amount of cells along each side of a render chunk
+const int chunk_side = 32;
+// random cells drawn for the Point before the free ones are searched instead
+const int relocation_attempts = 64;
+
+};  // namespace boardConstants
+
 /**
  * @brief Constants related to audio settings.
  */
@@ -38,8 +97,156 @@ const std::string move_path = "./assets/audio/move.wav";
 const std::string food_path = "./assets/audio/food.wav";
 const std::string gameover_path = "./assets/audio/gameover.wav";
 
+// distance up to which a positional sound plays at full volume
+const float ref_distance = 1.0f;
+// how quickly a positional sound fades beyond ref_distance
+const float rolloff = 0.5f;
+// seconds a sound effect may wait for a worker before it is dropped rather
+// than played late
+const double max_sound_delay = 0.1;
+
 };  // namespace audioConstants
 
+/**
+ * @brief Constants related to the logger.
+ *
+ * @see logger
+ */
+namespace logConstants {
+
+// amount of messages the ring buffer holds, must be a power of two
+const size_t capacity = 1024;
+const size_t message_size = 256;
+// minimum time, in seconds, between two messages with the same text
+const double rate_limit_interval = 1.0;
+// must be a power of two
+const size_t rate_limit_slots = 64;
+const int drain_interval_ms = 10;
+
+};  // namespace logConstants
+
+/**
+ * @brief Constants related to the frame profiler.
+ *
+ * @see profiler::Profiler
+ */
+namespace profilerConstants {
+
+// amount of frames each section's rolling statistics cover
+const int history_size = 128;
+// amount of frames a GPU query waits before being read back
+const int gpu_latency = 4;
+const float overlay_scale = 0.1f;
+const float overlay_x = -9.5f;
+const float overlay_y = 9.0f;
+const float overlay_line_gap = 0.6f;
+
+};  // namespace profilerConstants
+
+/**
+ * @brief Constants related to the trace event recorder.
+ *
+ * @see tracer
+ */
+namespace traceConstants {
+
+// amount of events each thread buffer holds before dropping
+const size_t buffer_events = 1 << 16;
+
+};  // namespace traceConstants
+
+/**
+ * @brief Constants related to the scripted benchmark mode.
+ *
+ * @see SessionOptions
+ */
+namespace benchConstants {
+
+// seed for the food placement, so that every run is the same
+const unsigned int seed = 42;
+// frames run before measuring, while caches and drivers warm up
+const long warmup_frames = 60;
+
+};  // namespace benchConstants
+
+/**
+ * @brief Constants related to the buffer dynamic vertex data is streamed
+ * through.
+ *
+ * @see StreamBuffer
+ */
+namespace streamConstants {
+
+// regions the buffer is split into, so the GPU may read this many frames back
+const int regions = 3;
+// bytes each region holds, enough for 80k Snake instances
+const size_t region_size = 1 << 21;
+// alignment of every allocation, in bytes
+const size_t alignment = 16;
+
+};  // namespace streamConstants
+
+/**
+ * @brief Constants related to capturing the main screen to video.
+ *
+ * @see VideoCapture
+ */
+namespace videoConstants {
+
+// pixel buffers frames are read into, so the GPU runs this far ahead
+const int pbo_count = 3;
+// frames waiting for the writer thread before new ones are dropped
+const int queued_frames = 8;
+// frame rate written to Y4M headers when the main screen isn't capped
+const int default_fps = 60;
+
+};  // namespace videoConstants
+
+/**
+ * @brief Constants related to the shared pool of worker threads.
+ *
+ * @see tasks
+ */
+namespace taskConstants {
+
+// bounds on the amount of workers, otherwise the hardware's thread count; the
+// music holds one for a whole game
+const unsigned int min_workers = 3;
+const unsigned int max_workers = 8;
+// tasks each priority's queue, and the main thread's, holds before
+// submissions fail
+const size_t queue_capacity = 64;
+// bytes a task's function and captures may take, stored inline
+const size_t task_size = 64;
+
+};  // namespace taskConstants
+
+/**
+ * @brief Constants related to networked sessions.
+ *
+ * @see GameServer
+ * @see GameClient
+ */
+namespace netConstants {
+
+const unsigned short default_port = 47800;
+const double default_tick_rate = 20.0;
+// ticks of deltas the server keeps, so clients further behind get a keyframe;
+// at most 255, as a snapshot counts its deltas in a byte
+const int history_ticks = 64;
+const int max_clients = 16;
+// seconds without a packet after which a client is dropped by the server, or
+// a client gives up on the server
+const double timeout = 2.0;
+// seconds between the inputs a client resends while it hears nothing back
+const double rejoin_interval = 0.1;
+// largest payload of a UDP datagram over IPv4
+const size_t max_packet = 65507;
+// latencies each client keeps for its report
+const size_t latency_samples = 1 << 16;
+
+};  // namespace netConstants
+
 /**
  * @brief Constants related to the font bitmap file.
  *
@@ -70,7 +277,7 @@ const int max_score_digits = 3;
 /**
  * @brief Constants related to 3D model data definition.
  *
- * @see Shape3D
+ * @see MeshRegistry
  */
 namespace modelConstants {
 
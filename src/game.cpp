@@ -12,11 +12,29 @@
 
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+
+#include "AllocationTracker.h"
+#include "Assets.h"
 #include "FontRenderer.h"
+#include "Framebuffer.h"
+#include "GLRecorder.h"
 #include "Include/glad/glad.h"
 #include "Include/glm/glm.hpp"
 #include "Include/glm/gtc/matrix_transform.hpp"
-#include "Shape3D.h"
+#include "Logger.h"
+#include "MeshRegistry.h"
+#include "StreamBuffer.h"
+#include "TaskPool.h"
+#include "Tracer.h"
+#include "VideoCapture.h"
 #include "camera.h"
 #include "constants.h"
 #include "gameHandler.h"
@@ -26,69 +44,275 @@
 int window_width = settingConstants::window_width;
 int window_height = settingConstants::window_height;
 
-int main() {
-  GLFWwindow *window = initializeWindow(window_width, window_height, "Snake3D");
+/**
+ * Accepted arguments:
+ * - `--trace <path>` records a Chrome trace of the session into path.
+ * - `--bench <frames>` skips the menus and measures the main screen for the
+ *   given amount of frames, with the Snake steered by an autopilot. In a
+ *   build with TRACK_ALLOCATIONS defined, exits with status 1 if any frame
+ *   past the warmup allocated.
+ * - `--bench-length <n>` makes the Snake start with n parts.
+ * - `--replay <path>` steers the benchmark with a recorded replay instead.
+ * - `--record <path>` records the inputs of each game into a replay.
+ * - `--vsync <interval>` waits for interval vertical blanks between buffer
+ *   swaps, 0 disabling vsync. Defaults to 1, or to 0 for benchmarks.
+ * - `--fps <rate>` caps the frame rate of the main screen.
+ * - `--tick-rate <rate>` moves the Snake rate times per second, 2 by default.
+ * - `--ramp` makes the tick rate grow with every point scored, up to 1000.
+ * - `--board <width>x<height>` plays on a board of the given amount of cells,
+ *   from 3 up to 4096 along each side. A single number gives a square board.
+ * - `--merge-segments` draws each straight run of the Snake as a single box.
+ * - `--headless <osmesa|egl>` renders without a display, through an OSMesa
+ *   or EGL context, into an offscreen framebuffer. Needs `--bench`, as there
+ *   is no window to take input from.
+ * - `--capture <path>` saves the last frame of the main screen as a PPM image.
+ * - `--golden <path>` compares the last frame of the main screen with a PPM
+ *   image, exiting with status 1 if they differ.
+ * - `--budget <path>` checks the GL calls of each benchmark frame against a
+ *   budget file, exiting with status 1 if any is exceeded. Needs a build with
+ *   RECORD_GL defined, see benchmarks/budgets.txt.
+ * - `--video <path>` captures every frame of the main screen to a video file,
+ *   Y4M if the path ends in `.y4m`, otherwise raw RGB24 at the window's size.
+ * - `--assets <dir>` prefers the shaders, font and sounds found under dir, at
+ *   their paths within src, over the ones compiled into the game.
+ */
+int main(int argc, char *argv[]) {
+  logger::start();
+
+  SessionOptions options;
+  bool vsyncGiven = false, optionsValid = true;
+  int headlessAPI = 0;
+  const char *capturePath = NULL, *goldenPath = NULL, *budgetPath = NULL;
+  const char *videoPath = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      tracer::start(argv[++i]);
+      tracer::nameThread("main");
+    } else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc)
+      options.benchFrames = atol(argv[++i]);
+    else if (strcmp(argv[i], "--bench-length") == 0 && i + 1 < argc)
+      options.startLength = std::max(1, atoi(argv[++i]));
+    else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+      options.replayPath = argv[++i];
+    else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+      options.recordPath = argv[++i];
+    else if (strcmp(argv[i], "--vsync") == 0 && i + 1 < argc) {
+      options.swapInterval = atoi(argv[++i]);
+      vsyncGiven = true;
+    } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+      options.fps = atof(argv[++i]);
+    else if (strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc)
+      options.tickRate = atof(argv[++i]);
+    else if (strcmp(argv[i], "--ramp") == 0)
+      options.speedRamp = true;
+    else if (strcmp(argv[i], "--merge-segments") == 0)
+      options.mergeSegments = true;
+    else if (strcmp(argv[i], "--headless") == 0 && i + 1 < argc) {
+      options.headless = true;
+      i++;
+      if (strcmp(argv[i], "egl") == 0)
+        headlessAPI = GLFW_EGL_CONTEXT_API;
+      else if (strcmp(argv[i], "osmesa") == 0)
+        headlessAPI = GLFW_OSMESA_CONTEXT_API;
+      else {
+        logger::log(logger::level::ERROR,
+                    "Unknown headless context %s, use osmesa or egl", argv[i]);
+        optionsValid = false;
+      }
+    } else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc)
+      capturePath = argv[++i];
+    else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc)
+      goldenPath = argv[++i];
+    else if (strcmp(argv[i], "--budget") == 0 && i + 1 < argc)
+      budgetPath = argv[++i];
+    else if (strcmp(argv[i], "--video") == 0 && i + 1 < argc)
+      videoPath = argv[++i];
+    else if (strcmp(argv[i], "--assets") == 0 && i + 1 < argc)
+      assets::setOverrides(argv[++i]);
+    else if (strcmp(argv[i], "--board") == 0 && i + 1 < argc) {
+      int width, height;
+      int read = sscanf(argv[++i], "%dx%d", &width, &height);
+      if (read >= 1) options.board = Board{width, read == 2 ? height : width};
+    }
+    else
+      logger::log(logger::level::WARNING, "Unknown argument %s", argv[i]);
+  }
+
+  if (options.startLength > options.board.maxStartLength()) {
+    options.startLength = options.board.maxStartLength();
+    logger::log(logger::level::WARNING,
+                "The Snake can start with at most %d parts on this board",
+                options.startLength);
+  }
+
+  // benchmarks measure the frame rate, so they run without vsync by default
+  if (options.benchFrames > 0 && !vsyncGiven) options.swapInterval = 0;
+
+  // without a window to take input from, the start screen would wait forever
+  if (options.headless && options.benchFrames == 0) {
+    logger::log(logger::level::ERROR,
+                "Headless sessions can't take input, use --bench");
+    optionsValid = false;
+  }
+  if (!optionsValid) {
+    tracer::stop();
+    logger::stop();
+    return 1;
+  }
+
+  tasks::start();
+
+  // files are read on the task pool while the window and its context are
+  // created, and their shaders compiled on this thread as it drains the
+  // tasks queued for it, the game's while the start screen shows
+  assets::Blob fontVertex, fontFragment, fontAtlas, snakeVertex,
+      snakeFragment;
+  std::unique_ptr<Shader> fontShader, shaderProgram;
+  double gameReady = 0.0;
+  tasks::asyncThen(
+      tasks::priority::NORMAL,
+      [&] {
+        tracer::Scope trace{"READ FONT ASSETS"};
+        assets::read("./shaders/font/shader.vs", fontVertex);
+        assets::read("./shaders/font/shader.fs", fontFragment);
+        assets::read("./assets/images/font.atlas", fontAtlas);
+      },
+      [&](std::future<void>) {
+        tracer::Scope trace{"COMPILE FONT SHADER"};
+        fontShader.reset(new Shader{fontVertex, fontFragment});
+      });
+  tasks::asyncThen(
+      tasks::priority::NORMAL,
+      [&] {
+        tracer::Scope trace{"READ GAME ASSETS"};
+        assets::read("./shaders/snake/shader.vs", snakeVertex);
+        assets::read("./shaders/snake/shader.fs", snakeFragment);
+        for (const std::string *path :
+             {&audioConstants::game_music_path, &audioConstants::move_path,
+              &audioConstants::food_path, &audioConstants::gameover_path})
+          assets::preload(path->c_str());
+      },
+      [&](std::future<void>) {
+        tracer::Scope trace{"COMPILE GAME SHADER"};
+        shaderProgram.reset(new Shader{snakeVertex, snakeFragment});
+        gameReady = millisSinceLaunch(options);
+      });
+
+  GLFWwindow *window =
+      initializeWindow(window_width, window_height, "Snake3D",
+                       options.swapInterval, headlessAPI);
+  double windowReady = millisSinceLaunch(options);
   if (window == NULL) {
     glfwTerminate();
+    tasks::stop();
+    tracer::stop();
+    logger::stop();
     return 1;
   }
 
+  int status = 0;
   {
-    Camera camera{glm::vec3(1.6f, 0.5f, 1.6f), glm::vec3(0.0f, 1.0f, 0.0f),
+    std::unique_ptr<Framebuffer> offscreen;
+    if (options.headless || capturePath != NULL || goldenPath != NULL) {
+      offscreen.reset(new Framebuffer{window_width, window_height});
+      options.offscreen = offscreen.get();
+    }
+    std::unique_ptr<VideoCapture> video;
+    if (videoPath != NULL) {
+      int fps = options.fps > 0.0 ? (int)std::lround(options.fps)
+                                  : videoConstants::default_fps;
+      video.reset(
+          new VideoCapture{videoPath, window_width, window_height, fps});
+      options.video = video.get();
+    }
+
+    Camera camera{options.board.cameraPosition(), glm::vec3(0.0f, 1.0f, 0.0f),
                   -45.17f, -38.32f};
 
-    Shape3D snakeShape{
-        sizeof(modelConstants::vertices_cube), modelConstants::vertices_cube,
-        sizeof(modelConstants::indices_cube), modelConstants::indices_cube};
-    snakeShape.bind();
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float),
-                          (void *)0);
-    glEnableVertexAttribArray(0);
-
-    Shape3D planeShape{
-        sizeof(modelConstants::vertices_plane), modelConstants::vertices_plane,
-        sizeof(modelConstants::indices_cube), modelConstants::indices_cube};
-    planeShape.bind();
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float),
-                          (void *)0);
-    glEnableVertexAttribArray(0);
-
-    Shape3D pointShape{
-        sizeof(modelConstants::vertices_cube), modelConstants::vertices_cube,
-        sizeof(modelConstants::indices_cube), modelConstants::indices_cube};
-    pointShape.bind();
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float),
-                          (void *)0);
-    glEnableVertexAttribArray(0);
-
-    Shape3D quadFontShape{
-        sizeof(modelConstants::vertices_quad), modelConstants::vertices_quad,
-        sizeof(modelConstants::indices_quad), modelConstants::indices_quad};
-
-    Shader shaderProgram{"./shaders/snake/shader.vs",
-                         "./shaders/snake/shader.fs"};
-    Shader fontShader{"./shaders/font/shader.vs", "./shaders/font/shader.fs"};
-
-    shaderProgram.use();
-    shaderProgram.setm4fv("view", camera.lookAt());
-    glm::mat4 projection;
-    projection = glm::perspective(glm::radians(settingConstants::zoom),
-                                  (float)window_width / (float)window_height,
-                                  0.1f, 100.0f);
-    shaderProgram.setm4fv("projection", projection);
-
-    FontRenderer font{"./assets/images/font.bmp",
+    MeshRegistry meshes;
+    Mesh cubeMesh = meshes.add(
+        modelConstants::vertices_cube, sizeof(modelConstants::vertices_cube),
+        modelConstants::indices_cube, sizeof(modelConstants::indices_cube),
+        {3});
+    Mesh planeMesh = meshes.add(
+        modelConstants::vertices_plane, sizeof(modelConstants::vertices_plane),
+        modelConstants::indices_cube, sizeof(modelConstants::indices_cube),
+        {3});
+    Mesh quadMesh = meshes.add(
+        modelConstants::vertices_quad, sizeof(modelConstants::vertices_quad),
+        modelConstants::indices_quad, sizeof(modelConstants::indices_quad),
+        {3, 2});
+    meshes.upload();
+    // the Snake's parts are given instance attributes, which the Point lacks
+    Mesh snakeMesh = meshes.separate(cubeMesh);
+
+    StreamBuffer stream;
+    options.stream = &stream;
+
+    {
+      tracer::Scope trace{"WAIT FONT"};
+      while (!fontShader) tasks::drain(true);
+    }
+    FontRenderer font{fontAtlas,
                       0,
-                      GL_RGB,
-                      quadFontShape,
-                      fontShader,
-                      "texture1"};
-
-    if (renderStartScreen(window, font))
-      while (initializeGame(window, shaderProgram, planeShape, snakeShape,
-                            pointShape, font));
+                      quadMesh,
+                      *fontShader,
+                      "texture1",
+                      &stream};
+    if (options.benchFrames == 0) presentStartScreen(window, font, options);
+    double fontReady = millisSinceLaunch(options);
+
+    if (options.benchFrames > 0 || renderStartScreen(window, font, options)) {
+      {
+        tracer::Scope trace{"WAIT GAME ASSETS"};
+        while (!shaderProgram) tasks::drain(true);
+      }
+      shaderProgram->use();
+      shaderProgram->setm4fv("view", camera.lookAt());
+      glm::mat4 projection;
+      projection = glm::perspective(glm::radians(settingConstants::zoom),
+                                    (float)window_width / (float)window_height,
+                                    0.1f * options.board.viewScale(),
+                                    100.0f * options.board.viewScale());
+      shaderProgram->setm4fv("projection", projection);
+      camera.setProjection(projection);
+      logger::log(logger::level::INFO,
+                  "Startup: window after %.1f ms, font after %.1f ms, "
+                  "game after %.1f ms",
+                  windowReady, fontReady, gameReady);
+
+      if (options.benchFrames > 0)
+        initializeGame(window, *shaderProgram, planeMesh, snakeMesh, cubeMesh,
+                       font, camera, options);
+      else
+        while (initializeGame(window, *shaderProgram, planeMesh, snakeMesh,
+                              cubeMesh, font, camera, options));
+    }
+
+    if (capturePath != NULL && !offscreen->save(capturePath)) status = 1;
+    if (goldenPath != NULL) {
+      long mismatches = offscreen->compare(goldenPath,
+                                           frameConstants::golden_tolerance);
+      if (mismatches == 0)
+        logger::log(logger::level::INFO, "Last frame matches %s", goldenPath);
+      else {
+        if (mismatches > 0)
+          logger::log(logger::level::ERROR,
+                      "Last frame differs from %s in %ld pixels", goldenPath,
+                      mismatches);
+        status = 1;
+      }
+    }
+    if (budgetPath != NULL && !glrecord::check(budgetPath)) status = 1;
+    if (options.benchFrames > 0 && !allocation::check()) status = 1;
   }
+  // the shaders go before their context does
+  fontShader.reset();
+  shaderProgram.reset();
 
   glfwTerminate();
-  return 0;
+  tasks::stop();
+  tracer::stop();
+  logger::stop();
+  return status;
 }
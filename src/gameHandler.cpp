@@ -9,207 +9,496 @@
  */
 #include "gameHandler.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <random>
-#include <thread>
+#include <utility>
+#include <vector>
 
+#include "AllocationTracker.h"
 #include "AudioHandler.h"
+#include "ChunkGrid.h"
+#include "FrameLimiter.h"
+#include "GLRecorder.h"
+#include "GLStats.h"
+#include "Logger.h"
+#include "PartInstances.h"
+#include "Profiler.h"
+#include "Replay.h"
+#include "Simulation.h"
+#include "SoundEffects.h"
+#include "TaskPool.h"
+#include "Tracer.h"
 #include "process_input.h"
 
-snake::movement current = snake::movement::DOWN;
+extern int window_width;
+extern int window_height;
 
-std::mt19937 rng(time(NULL));
-std::uniform_int_distribution<int> gen(0,
-                                       (int)(2 / modelConstants::scale_factor -
-                                             0.5f));
+std::atomic<snake::movement> current{snake::movement::DOWN};
+bool profiler_overlay = false;
+// set whenever the window's contents are damaged or resized
+bool redraw_needed = true;
+
+namespace {
+
+/**
+ * @brief Log the results of a benchmark run.
+ *
+ * @param frameTimes time taken by each measured frame, in milliseconds
+ * @param startLength amount of parts the Snake started with
+ * @param endLength amount of parts the Snake ended with
+ * @param collisions amount of ignored self collisions
+ */
+void reportBench(std::vector<float> &frameTimes, int startLength,
+                 size_t endLength, unsigned long collisions) {
+  const size_t frames = frameTimes.size();
+  if (frames == 0) return;
+  double seconds = 0.0;
+  for (float ms : frameTimes) seconds += ms / 1000.0;
+  std::sort(frameTimes.begin(), frameTimes.end());
+  auto percentile = [&](float p) {
+    return frameTimes[std::min(frames - 1, (size_t)(p * frames))];
+  };
+  const glstats::Counters &calls = glstats::get();
+
+  logger::log(logger::level::INFO, "Bench renderer: %s, %s",
+              (const char *)glGetString(GL_RENDERER),
+              (const char *)glGetString(GL_VERSION));
+  logger::log(logger::level::INFO,
+              "Bench: %zu frames in %.3f s, %.1f FPS, Snake length %d to %zu",
+              frames, seconds, frames / seconds, startLength, endLength);
+  logger::log(logger::level::INFO,
+              "Bench frame ms: avg %.3f p50 %.3f p90 %.3f p99 %.3f max %.3f",
+              seconds * 1000.0 / frames, percentile(0.5f),
+              percentile(0.9f), percentile(0.99f), frameTimes.back());
+  logger::log(logger::level::INFO,
+              "Bench per frame: %.1f draw calls, %.1f uniform uploads",
+              (double)calls.drawCalls / frames,
+              (double)calls.uniformUploads / frames);
+  logger::log(logger::level::INFO,
+              "Bench per frame: %.1f instances drawn, %.1f culled",
+              (double)calls.instancesDrawn / frames,
+              (double)calls.instancesCulled / frames);
+  if (collisions > 0)
+    logger::log(logger::level::INFO, "Bench: %lu self collisions ignored",
+                collisions);
+}
+
+/**
+ * @brief Get how far along a Snapshot's tick is towards the next one.
+ *
+ * @param view the Snapshot
+ *
+ * @return the fraction of the tick gone by, or 1 when ticks are stepped
+ * manually
+ */
+float tickAlpha(const Snapshot &view) {
+  if (view.period <= 0.0) return 1.0f;
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - view.published;
+  return (float)std::min(elapsed.count() / view.period, 1.0);
+}
+
+/**
+ * @brief Check whether or not the window can be seen at all.
+ *
+ * GLFW can't tell whether the window is covered by others, so only hidden
+ * and iconified windows are considered unseen.
+ *
+ * @param window current session's window
+ *
+ * @return true if it may be seen, otherwise false
+ */
+bool windowVisible(GLFWwindow *window) {
+  return glfwGetWindowAttrib(window, GLFW_VISIBLE) &&
+         !glfwGetWindowAttrib(window, GLFW_ICONIFIED);
+}
+
+/**
+ * @brief Sleep until an event arrives or a deadline passes.
+ *
+ * Unseen windows only wake up on events, as they have nothing to redraw.
+ *
+ * @param window current session's window
+ * @param deadline time to wake up at, as given by glfwGetTime
+ */
+void waitForEvents(GLFWwindow *window, double deadline) {
+  if (!windowVisible(window)) {
+    glfwWaitEvents();
+    return;
+  }
+  double timeout = deadline - glfwGetTime();
+  if (timeout > 0.0)
+    glfwWaitEventsTimeout(timeout);
+  else
+    glfwPollEvents();
+}
+
+/**
+ * @brief Swap the window's buffers, logging how long after launch the first
+ * frame was presented.
+ *
+ * @param window current session's window
+ * @param options the session's options
+ */
+void presentFrame(GLFWwindow *window, const SessionOptions &options) {
+  static bool presented = false;
+  glfwSwapBuffers(window);
+  if (presented) return;
+  presented = true;
+  tracer::instant("FIRST FRAME");
+  logger::log(logger::level::INFO, "First frame presented %.1f ms after launch",
+              millisSinceLaunch(options));
+}
+
+/**
+ * @brief Draw the start menu screen.
+ *
+ * @param font font's renderer
+ * @param blink whether or not the prompt is shown
+ */
+void drawStartScreen(FontRenderer &font, bool blink) {
+  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+  font.writeText("SNAKE3D", 0.8f, -0.85f, 0.45f, 0.3f, 0.5f, "texPos",
+                 "model");
+  if (blink)
+    font.writeText("PRESS ENTER TO START", 0.25f, -2.8f, -2.2f, 0.3f, 0.5f,
+                   "texPos", "model");
+}
+
+/**
+ * @brief Write a game's replay on the task pool, so that the game over screen
+ * never waits on the file.
+ *
+ * @param replay the game's replay
+ * @param path path of the replay file
+ *
+ * A game's replay is only written once the previous game's is.
+ */
+void saveReplay(Replay &&replay, const char *path) {
+  static std::future<void> saving;
+  if (saving.valid()) saving.wait();
+  saving = tasks::async(tasks::priority::LOW,
+                        [replay = std::move(replay), path] {
+                          tracer::Scope trace{"SAVE REPLAY"};
+                          replay.save(path);
+                        });
+}
+
+};  // namespace
+
+double millisSinceLaunch(const SessionOptions &options) {
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - options.launched;
+  return elapsed.count();
+}
 
 bool initializeGame(GLFWwindow *window, Shader &shaderProgram,
-                    Shape3D &planeShape, Shape3D &snakeShape,
-                    Shape3D &pointShape, FontRenderer &font) {
+                    const Mesh &planeMesh, const Mesh &snakeMesh,
+                    const Mesh &pointMesh, FontRenderer &font,
+                    Camera &camera, const SessionOptions &options) {
   current = snake::movement::DOWN;
+  if (options.benchFrames > 0) rng.seed(benchConstants::seed);
   Score score;
   bool rc;
 
-  glm::mat4 planeModel = glm::mat4(1.0f);
-  planeModel = glm::rotate(planeModel, glm::radians(-90.0f),
-                           glm::vec3(1.0f, 0.0f, 0.0f));
+  const Board &board = options.board;
 
-  snake::Snake snek{glm::vec3(-modelConstants::scale_factor / 2,
-                              modelConstants::scale_factor / 2 - 0.995f,
-                              -modelConstants::scale_factor / 2),
-                    3,
+  snake::Snake snek{board.center(),
+                    options.startLength,
                     modelConstants::scale_factor,
                     modelConstants::scale_factor,
-                    0.95f,
-                    0.95f,
-                    current};
-  Point point{glm::vec3(-modelConstants::scale_factor / 2,
-                        modelConstants::scale_factor / 2 - 0.995f,
-                        -modelConstants::scale_factor / 2),
-              modelConstants::scale_factor};
+                    board.borderX(),
+                    board.borderZ(),
+                    current,
+                    board.reservedParts(options.startLength)};
+  Point point{board.center(), modelConstants::scale_factor};
 
   // avoid a point spawning within the Snake
-  while (snek.pointCollisionAll(point.getTrans())) {
-    point = Point{glm::vec3(modelConstants::scale_factor * gen(rng) +
-                                modelConstants::scale_factor / 2 - 1,
-                            modelConstants::scale_factor / 2 - 0.995f,
-                            modelConstants::scale_factor * gen(rng) +
-                                modelConstants::scale_factor / 2 - 1),
-                  modelConstants::scale_factor};
-  }
+  relocatePoint(snek, point, board);
 
-  rc = renderMainScreen(window, snek, point, score, shaderProgram, planeShape,
-                        snakeShape, pointShape, font, planeModel);
-  if (rc) return renderGameOverScreen(window, font, score);
+  rc = renderMainScreen(window, snek, point, score, shaderProgram, planeMesh,
+                        snakeMesh, pointMesh, font, camera, options);
+  if (rc) return renderGameOverScreen(window, font, score, options);
   return rc;
 }
 
+/**
+ * The Snake is ticked by a Simulation on its own thread, and each frame draws
+ * the latest Snapshot it published, so a slow frame never delays a tick. The
+ * parts are drawn moving from where they stood before the tick to where they
+ * stand after it, so the Snake glides between ticks.
+ *
+ * Benchmark runs instead step the Simulation on this thread once per frame,
+ * so that they are deterministic. They skip every sound, and their frame
+ * times are kept in memory reserved up front, so that measuring does not
+ * disturb the frames.
+ */
 bool renderMainScreen(GLFWwindow *window, snake::Snake &snek, Point &point,
-                      Score &score, Shader &shaderProgram, Shape3D &planeShape,
-                      Shape3D &snakeShape, Shape3D &pointShape,
-                      FontRenderer &font, glm::mat4 planeModel) {
-  AudioHandler music, move, food;
-  std::thread music_audio(
-
-      [&music](const std::string &path) {
-        while (music.playAudio(path, 0.08f));
-      },
-      audioConstants::game_music_path);
-  double lastTime = glfwGetTime();
+                      Score &score, Shader &shaderProgram,
+                      const Mesh &planeMesh, const Mesh &snakeMesh,
+                      const Mesh &pointMesh, FontRenderer &font,
+                      Camera &camera, const SessionOptions &options) {
+  const bool bench = options.benchFrames > 0;
+  Replay replay;
+  const bool replaying = bench && options.replayPath != NULL &&
+                         replay.load(options.replayPath);
+  const bool recording = !bench && options.recordPath != NULL;
+
+  AudioHandler music;
+  tasks::Group musicTask;
+  if (!bench)
+    musicTask.submit(tasks::priority::LOW, [&music] {
+      tracer::Scope trace{"MUSIC"};
+      while (music.playAudio(audioConstants::game_music_path, 0.08f));
+    });
+
+  std::vector<float> frameTimes;
+  if (bench) frameTimes.reserve(options.benchFrames);
+  long frameCount = 0;
+  unsigned long collisions = 0;
+  auto frameStart = std::chrono::steady_clock::now();
+
+  SoundEffects sounds{camera};
+  Simulation simulation{snek,
+                        point,
+                        score,
+                        options.board,
+                        bench ? nullptr : &sounds,
+                        recording ? &replay : nullptr,
+                        options.board.reservedParts(snek.getLength())};
+  if (!bench)
+    simulation.start(current, options.tickRate, options.speedRamp);
+
+  ChunkGrid chunks{options.board};
+  PartInstances instances{options.board.reservedParts(snek.getLength()),
+                          options.stream};
+  snakeMesh.bind();
+  instances.attach();
+  const GLint modelLocation = shaderProgram.location("model");
+  profiler::Profiler frameProfiler;
+  FrameLimiter limiter{options.fps};
+  bool over = false;
   while (!glfwWindowShouldClose(window)) {
-    processInput(window);
-
-    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    shaderProgram.use();
-    shaderProgram.setm4fv("model", planeModel);
-
-    shaderProgram.setv4fv("ourColor", modelConstants::colorPlane);
-    planeShape.bind();
-    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-
-    snek.updateDirection(current);
+    // work queued for this thread, such as uploads, may allocate
+    tasks::drain();
+    allocation::FrameScope frame;
+    tracer::Scope traceFrame{"FRAME"};
+    frameProfiler.beginFrame();
+    {
+      profiler::Scope scope{frameProfiler, profiler::section::INPUT};
+      processInput(window);
+      if (replaying)
+        current = replay.directionAt(simulation.snapshot().tick, current);
+      else if (bench)
+        current = autopilot(snek, point.getTrans(), current);
+    }
 
-    double currentTime = glfwGetTime();
-    if (currentTime - lastTime >= settingConstants::delay) {
-      snek.move();
+    if (bench && simulation.step(current)) collisions++;
+    bool ticked = simulation.update();
+    if (ticked)
+      frameProfiler.record(profiler::section::TICK,
+                           simulation.snapshot().tickMicros);
+    Snapshot &view = simulation.snapshot();
+    if (view.collided && !bench) {
+      over = true;
+      break;
+    }
 
-      if (snek.selfCollision()) {
-        music.stopAudio();
-        music_audio.join();
-        return true;
-      }
+    Frustum frustum{camera.getProjection() * camera.lookAt()};
+    {
+      profiler::Scope scope{frameProfiler, profiler::section::PLANE, true};
+      if (options.offscreen != NULL) options.offscreen->bind();
+      glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+      chunks.cull(frustum);
+      shaderProgram.use();
+      shaderProgram.setv4fv("ourColor", modelConstants::colorPlane);
+      planeMesh.bind();
+      chunks.drawPlane(planeMesh, modelLocation);
+    }
 
-      if (snek.pointCollisionHead(point.getTrans())) {
-        score.updateScore();
-        snek.addPart();
-        std::thread food_audio(
-
-            [&food](const std::string &path) { food.playAudio(path, 0.2f); },
-            audioConstants::food_path);
-        food_audio.detach();
-        while (snek.pointCollisionAll(point.getTrans())) {
-          point = Point{glm::vec3(modelConstants::scale_factor * gen(rng) +
-                                      modelConstants::scale_factor / 2 - 1,
-                                  modelConstants::scale_factor / 2 - 0.995f,
-                                  modelConstants::scale_factor * gen(rng) +
-                                      modelConstants::scale_factor / 2 - 1),
-                        modelConstants::scale_factor};
+    {
+      profiler::Scope scope{frameProfiler, profiler::section::SNAKE, true};
+      shaderProgram.setv4fv("ourColor", modelConstants::colorSnake);
+      snakeMesh.bind();
+      if (options.mergeSegments)
+        for (auto &segment : view.segments) {
+          bool seen = frustum.intersects(segment.min(), segment.max());
+          glstats::countInstance(seen);
+          if (seen) snakeMesh.draw(segment.model(), modelLocation);
         }
-      } else {
-        std::thread move_audio(
-
-            [&move](const std::string &path) { move.playAudio(path, 0.2f); },
-            audioConstants::move_path);
-        move_audio.detach();
+      else {
+        // instances are kept until the Snake moves or the view culls others
+        if (ticked || chunks.visibilityChanged())
+          instances.upload(view.motions, chunks);
+        instances.draw(snakeMesh, shaderProgram, tickAlpha(view));
       }
-
-      lastTime = currentTime;
     }
 
-    shaderProgram.setv4fv("ourColor", modelConstants::colorSnake);
-    snakeShape.bind();
-    snek.draw(shaderProgram.ID, "model");
+    {
+      profiler::Scope scope{frameProfiler, profiler::section::POINT, true};
+      shaderProgram.setv4fv("ourColor", modelConstants::colorPoint);
+      pointMesh.bind();
+      bool seen = chunks.isVisible(view.point.getTrans());
+      glstats::countInstance(seen);
+      if (seen) pointMesh.draw(view.point.model(), modelLocation);
+    }
 
-    shaderProgram.setv4fv("ourColor", modelConstants::colorPoint);
-    pointShape.bind();
-    point.draw(shaderProgram.ID, "model");
+    {
+      profiler::Scope scope{frameProfiler, profiler::section::SCORE, true};
+      // drawing score
+      font.writeText(view.score.getScoreStr(), 0.25f, 3.3f, 3.8f, 0.3f, 0.5f,
+                     "texPos", "model");
+    }
 
-    // drawing score
-    font.writeText(score.getScoreStr(), 0.25f, 3.3f, 3.8f, 0.3f, 0.5f, "texPos",
-                   "model");
+    if (profiler_overlay) frameProfiler.draw(font);
+    if (options.offscreen != NULL && !options.headless)
+      options.offscreen->blit(window_width, window_height);
+    if (options.video != NULL) {
+      profiler::Scope scope{frameProfiler, profiler::section::VIDEO};
+      options.video->grab(options.headless ? options.offscreen->getFBO() : 0);
+    }
 
     // check and call events and swap the buffers
-    glfwSwapBuffers(window);
+    {
+      profiler::Scope scope{frameProfiler, profiler::section::SWAP};
+      presentFrame(window, options);
+    }
+    if (options.stream != NULL) options.stream->endFrame();
     glfwPollEvents();
+    limiter.wait();
+
+    if (bench) {
+      // offscreen frames are waited for, so that software renderers are
+      // measured by how long they take to draw rather than to queue
+      if (options.offscreen != NULL) glFinish();
+      auto frameEnd = std::chrono::steady_clock::now();
+      std::chrono::duration<float, std::milli> elapsed = frameEnd - frameStart;
+      frameStart = frameEnd;
+      if (++frameCount == benchConstants::warmup_frames) {
+        glstats::reset();
+        glrecord::reset();
+        allocation::reset();
+      } else if (frameCount > benchConstants::warmup_frames) {
+        glrecord::endFrame();
+        frameTimes.push_back(elapsed.count());
+        if ((long)frameTimes.size() >= options.benchFrames) break;
+      }
+    }
   }
+  simulation.stop();
   music.stopAudio();
-  music_audio.join();
-  return false;
+  musicTask.wait();
+  if (recording) saveReplay(std::move(replay), options.recordPath);
+  limiter.report("Main screen");
+
+  if (bench)
+    reportBench(frameTimes, options.startLength, snek.getLength(), collisions);
+  return over;
+}
+
+void presentStartScreen(GLFWwindow *window, FontRenderer &font,
+                        const SessionOptions &options) {
+  drawStartScreen(font, true);
+  presentFrame(window, options);
+  if (options.stream != NULL) options.stream->endFrame();
 }
 
-bool renderStartScreen(GLFWwindow *window, FontRenderer &font) {
-  double lastTime = glfwGetTime();
+/**
+ * The screen is only drawn when the prompt blinks or the window is damaged,
+ * and waits for events in between, so it stays idle otherwise. Its pace is
+ * set by the blinks, so it needs no frame limiter.
+ */
+bool renderStartScreen(GLFWwindow *window, FontRenderer &font,
+                       const SessionOptions &options) {
+  double nextBlink = glfwGetTime() + frameConstants::blink_interval;
   bool blink = true;
+  unsigned long redraws = 0;
+  redraw_needed = true;
   while (!glfwWindowShouldClose(window)) {
+    tasks::drain();
+    allocation::FrameScope frame;
     processInput(window, false);
-    if (glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS) return true;
-
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    font.writeText("SNAKE3D", 0.8f, -0.85f, 0.45f, 0.3f, 0.5f, "texPos",
-                   "model");
+    if (glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS) break;
 
     double currentTime = glfwGetTime();
-    if (currentTime - lastTime > 1.0f) {
+    if (currentTime >= nextBlink) {
       blink = !blink;
-      lastTime = currentTime;
+      nextBlink = currentTime + frameConstants::blink_interval;
+      redraw_needed = true;
     }
-    if (blink)
-      font.writeText("PRESS ENTER TO START", 0.25f, -2.8f, -2.2f, 0.3f, 0.5f,
-                     "texPos", "model");
 
-    glfwSwapBuffers(window);
-    glfwPollEvents();
+    if (redraw_needed && windowVisible(window)) {
+      redraw_needed = false;
+      redraws++;
+      drawStartScreen(font, blink);
+      presentFrame(window, options);
+      if (options.stream != NULL) options.stream->endFrame();
+    }
+    waitForEvents(window, nextBlink);
   }
-  return false;
+  logger::log(logger::level::DEBUG, "Start screen drew %lu frames", redraws);
+  return !glfwWindowShouldClose(window);
 }
 
+/**
+ * As with the start screen, the screen is only drawn when the prompt blinks
+ * or the window is damaged.
+ */
 bool renderGameOverScreen(GLFWwindow *window, FontRenderer &font,
-                          Score &score) {
+                          Score &score, const SessionOptions &options) {
   AudioHandler gameover;
-  std::thread gameover_audio(
-
-      [&gameover](const std::string &path) { gameover.playAudio(path, 0.2f); },
-      audioConstants::gameover_path);
-  gameover_audio.detach();
-  double lastTime = glfwGetTime();
+  tasks::Group soundTask;
+  soundTask.submit(tasks::priority::HIGH, [&gameover] {
+    tracer::Scope trace{"SOUND"};
+    gameover.playAudio(audioConstants::gameover_path, 0.2f);
+  });
+  double nextBlink = glfwGetTime() + frameConstants::blink_interval;
   bool blink = true;
+  unsigned long redraws = 0;
+  redraw_needed = true;
   std::string scoreStr = std::to_string(score.getScore());
+  const std::string scoreText = "SCORE " + scoreStr;
   while (!glfwWindowShouldClose(window)) {
+    tasks::drain();
+    allocation::FrameScope frame;
     processInput(window, false);
-    if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS) return true;
-
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    font.writeText("SCORE " + scoreStr, 0.25f, -0.5f - 0.2f * scoreStr.size(),
-                   3.5f, 0.3f, 0.5f, "texPos", "model");
-    font.writeText("GAME\nOVER", 0.8f, -0.4f, 0.6f, 0.3f, 0.5f, "texPos",
-                   "model");
+    if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS) break;
 
     double currentTime = glfwGetTime();
-    if (currentTime - lastTime > 1.0f) {
+    if (currentTime >= nextBlink) {
       blink = !blink;
-      lastTime = currentTime;
+      nextBlink = currentTime + frameConstants::blink_interval;
+      redraw_needed = true;
     }
-    if (blink)
-      font.writeText("PRESS R TO RESTART", 0.25f, -2.5f, -2.2f, 0.3f, 0.5f,
-                     "texPos", "model");
 
-    glfwSwapBuffers(window);
-    glfwPollEvents();
+    if (redraw_needed && windowVisible(window)) {
+      redraw_needed = false;
+      redraws++;
+      glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+      font.writeText(scoreText.c_str(), 0.25f, -0.5f - 0.2f * scoreStr.size(),
+                     3.5f, 0.3f, 0.5f, "texPos", "model");
+      font.writeText("GAME\nOVER", 0.8f, -0.4f, 0.6f, 0.3f, 0.5f, "texPos",
+                     "model");
+      if (blink)
+        font.writeText("PRESS R TO RESTART", 0.25f, -2.5f, -2.2f, 0.3f, 0.5f,
+                       "texPos", "model");
+
+      presentFrame(window, options);
+      if (options.stream != NULL) options.stream->endFrame();
+    }
+    waitForEvents(window, nextBlink);
   }
-  return false;
+  gameover.stopAudio();
+  logger::log(logger::level::DEBUG, "Game over screen drew %lu frames",
+              redraws);
+  return !glfwWindowShouldClose(window);
 }
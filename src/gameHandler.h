@@ -15,32 +15,81 @@
 
 #include <GLFW/glfw3.h>
 
+#include <chrono>
+
+#include "Board.h"
 #include "FontRenderer.h"
+#include "Framebuffer.h"
+#include "GameRules.h"
 #include "Point.h"
 #include "Score.h"
-#include "Shape3D.h"
+#include "MeshRegistry.h"
 #include "Snake.h"
+#include "StreamBuffer.h"
+#include "VideoCapture.h"
+#include "camera.h"
+#include "constants.h"
 #include "shader.h"
 
+/**
+ * @brief Options of a game session, given on the command line.
+ */
+struct SessionOptions {
+  // frames to measure in the scripted benchmark, or 0 for a regular game
+  long benchFrames = 0;
+  // amount of parts the Snake starts with
+  int startLength = 3;
+  // replay driving the benchmark instead of the autopilot, if any
+  const char *replayPath = NULL;
+  // file the inputs of each game are recorded into, if any
+  const char *recordPath = NULL;
+  // vertical blanks to wait for between buffer swaps, 0 disables vsync
+  int swapInterval = frameConstants::swap_interval;
+  // frame rate cap of the main screen, or 0 to leave it to vsync
+  double fps = 0.0;
+  // ticks per second the Snake starts moving at
+  double tickRate = 1.0 / settingConstants::delay;
+  // whether or not the tick rate grows as the score rises
+  bool speedRamp = false;
+  // whether or not the Snake is drawn as its straight runs, one box each
+  bool mergeSegments = false;
+  // the board the game is played on
+  Board board;
+  // whether or not the window is hidden and needs no display
+  bool headless = false;
+  // framebuffer the main screen renders into instead of the window's, if any
+  Framebuffer *offscreen = NULL;
+  // video every frame of the main screen is captured to, if any
+  VideoCapture *video = NULL;
+  // buffer dynamic vertex data is streamed through, if any
+  StreamBuffer *stream = NULL;
+  // when the session was launched, which startup times are measured from
+  std::chrono::steady_clock::time_point launched =
+      std::chrono::steady_clock::now();
+};
+
 /**
  * @brief Initialize the game.
  *
  * @param window current session's window
  * @param shaderProgram main model shader program
- * @param planeShape plane the other objects stand on
- * @param snakeShape shape for the Snake
- * @param pointShape shape for the Point
+ * @param planeMesh plane the other objects stand on
+ * @param snakeMesh mesh for the Snake, with instance attributes
+ * @param pointMesh mesh for the Point
  * @param font font's renderer
+ * @param camera scene Camera, used as the audio listener
+ * @param options the session's options
  *
- * @see Shape3D
+ * @see Mesh
  * @see Shader
  * @see FontRenderer
  *
  * @return whether or not a restart command was given
  */
 bool initializeGame(GLFWwindow *window, Shader &shaderProgram,
-                    Shape3D &planeShape, Shape3D &snakeShape,
-                    Shape3D &pointShape, FontRenderer &font);
+                    const Mesh &planeMesh, const Mesh &snakeMesh,
+                    const Mesh &pointMesh, FontRenderer &font,
+                    Camera &camera, const SessionOptions &options);
 
 /**
  * @brief Render the main game screen.
@@ -50,36 +99,66 @@ bool initializeGame(GLFWwindow *window, Shader &shaderProgram,
  * @param point game Point
  * @param score game Score
  * @param shaderProgram main model shader program
- * @param planeShape plane the other objects stand on
- * @param snakeShape shape for the Snake
- * @param pointShape shape for the Point
+ * @param planeMesh plane the other objects stand on
+ * @param snakeMesh mesh for the Snake, with instance attributes
+ * @param pointMesh mesh for the Point
  * @param font font's renderer
- * @param planeModel plane 4D model matrix
+ * @param camera scene Camera, used as the audio listener and for culling
+ * @param options the session's options
+ *
+ * In benchmark mode, the Snake moves once every frame, steered by the
+ * autopilot or a replay, and self collisions don't end the game. Once the
+ * frames are run, the frame rate and per frame statistics are logged.
  *
  * @return whether or not a restart command was given
  */
 bool renderMainScreen(GLFWwindow *window, snake::Snake &snek, Point &point,
-                      Score &score, Shader &shaderProgram, Shape3D &planeShape,
-                      Shape3D &snakeShape, Shape3D &pointShape,
-                      FontRenderer &font, glm::mat4 planeModel);
+                      Score &score, Shader &shaderProgram,
+                      const Mesh &planeMesh, const Mesh &snakeMesh,
+                      const Mesh &pointMesh, FontRenderer &font,
+                      Camera &camera, const SessionOptions &options);
+/**
+ * @brief Get the time elapsed since the session was launched.
+ *
+ * @param options the session's options
+ *
+ * @return the elapsed time, in milliseconds
+ */
+double millisSinceLaunch(const SessionOptions &options);
+/**
+ * @brief Draw a single frame of the start menu screen.
+ *
+ * @param window current session's window
+ * @param font font's renderer
+ * @param options the session's options
+ *
+ * Meant to show the start screen as soon as the font is loaded, while the
+ * rest of the game still loads.
+ */
+void presentStartScreen(GLFWwindow *window, FontRenderer &font,
+                        const SessionOptions &options);
 /**
  * @brief Render the start menu screen.
  *
  * @param window current session's window
  * @param font font's renderer
+ * @param options the session's options
  *
  * @return whether or not a start game command was given
  */
-bool renderStartScreen(GLFWwindow *window, FontRenderer &font);
+bool renderStartScreen(GLFWwindow *window, FontRenderer &font,
+                       const SessionOptions &options);
 /**
  * @brief Render the game over screen.
  *
  * @param window current session's window
  * @param font font's renderer
  * @param Score game scor
+ * @param options the session's options
  *
  * @return whether or not a restart command was given
  */
-bool renderGameOverScreen(GLFWwindow *window, FontRenderer &font, Score &score);
+bool renderGameOverScreen(GLFWwindow *window, FontRenderer &font, Score &score,
+                          const SessionOptions &options);
 
 #endif
@@ -8,26 +8,41 @@
  */
 #include "process_input.h"
 
-#include <iostream>
+#include <atomic>
 
+#include "GLRecorder.h"
+#include "Logger.h"
 #include "SnakePart.h"
+#include "Tracer.h"
 
 extern int window_height;
 extern int window_width;
 
-extern snake::movement current;
+extern std::atomic<snake::movement> current;
+extern bool profiler_overlay;
+extern bool redraw_needed;
 
-void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
+void framebuffer_size_callback(GLFWwindow *window, int width, int height) {
   glViewport(0, 0, width, height);
   window_height = height;
   window_width = width;
+  redraw_needed = true;
 }
 
-void processInput(GLFWwindow* window, bool gameOn) {
+void window_refresh_callback(GLFWwindow *window) { redraw_needed = true; }
+
+void processInput(GLFWwindow *window, bool gameOn) {
+  // the overlay only toggles once per key press, not once per frame held
+  static bool overlayKeyHeld = false;
+  bool overlayKey = glfwGetKey(window, GLFW_KEY_F3) == GLFW_PRESS;
+  if (overlayKey && !overlayKeyHeld) profiler_overlay = !profiler_overlay;
+  overlayKeyHeld = overlayKey;
+
   if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
     glfwSetWindowShouldClose(window, true);
 
   else if (gameOn) {
+    snake::movement previous = current;
     if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
       current = snake::movement::LEFT;
     else if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
@@ -36,37 +51,53 @@ void processInput(GLFWwindow* window, bool gameOn) {
       current = snake::movement::UP;
     else if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
       current = snake::movement::DOWN;
+    if (current != previous) tracer::instant("INPUT");
   }
 }
 
-GLFWwindow* initializeWindow(const unsigned int width,
-                             const unsigned int height, const char* title) {
+/**
+ * Headless windows use GLFW's null platform where available, so that no
+ * display server is needed, and are never shown.
+ */
+GLFWwindow *initializeWindow(const unsigned int width,
+                             const unsigned int height, const char *title,
+                             int swapInterval, int headlessAPI) {
+#ifdef GLFW_PLATFORM_NULL
+  if (headlessAPI != 0) glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
   glfwInit();
   glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
   glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
   glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+  if (headlessAPI != 0) {
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, headlessAPI);
+  }
 
 #ifdef __APPLE__
   glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
-  GLFWwindow* window = glfwCreateWindow(width, height, title, NULL, NULL);
+  GLFWwindow *window = glfwCreateWindow(width, height, title, NULL, NULL);
   if (window == NULL) {
-    std::cout << "Failed to create GLFW window" << std::endl;
+    logger::log(logger::level::ERROR, "Failed to create GLFW window");
     return NULL;
   }
   glfwMakeContextCurrent(window);
 
   if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-    std::cout << "Failed to initialize GLAD" << std::endl;
+    logger::log(logger::level::ERROR, "Failed to initialize GLAD");
     return NULL;
   }
+  glrecord::install();
 
+  glfwSwapInterval(swapInterval);
   glEnable(GL_DEPTH_TEST);
 
   glViewport(0, 0, width, height);
 
   glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+  glfwSetWindowRefreshCallback(window, window_refresh_callback);
 
   return window;
 }
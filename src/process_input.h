@@ -16,14 +16,17 @@
 #include <GLFW/glfw3.h>
 
 #include "camera.h"
+#include "constants.h"
 
 /**
  * @brief Processes keyboard input.
  *
+ * F3 toggles the frame profiler overlay.
+ *
  * @param window current session's window
  * @param gameOn whether or not the game is running
  */
-void processInput(GLFWwindow* window, bool gameOn = true);
+void processInput(GLFWwindow *window, bool gameOn = true);
 
 /**
  * @brief Initializes the session window.
@@ -31,10 +34,17 @@ void processInput(GLFWwindow* window, bool gameOn = true);
  * @param width window width value
  * @param height window height value
  * @param title window title
+ * @param swapInterval vertical blanks to wait for between buffer swaps, 0
+ * disabling vsync
+ * @param headlessAPI GLFW context creation API of a hidden window with no
+ * display, GLFW_OSMESA_CONTEXT_API or GLFW_EGL_CONTEXT_API, or 0 for a
+ * regular window
  *
  * @return pointer to the created window, or null if failed
  */
-GLFWwindow* initializeWindow(const unsigned int width,
-                             const unsigned int height, const char* title);
+GLFWwindow *initializeWindow(const unsigned int width,
+                             const unsigned int height, const char *title,
+                             int swapInterval = frameConstants::swap_interval,
+                             int headlessAPI = 0);
 
 #endif
@@ -0,0 +1,167 @@
+/**
+ * @file server.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Game server entrypoint.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Board.h"
+#include "GameClient.h"
+#include "GameServer.h"
+#include "Logger.h"
+#include "TaskPool.h"
+#include "Tracer.h"
+#include "constants.h"
+
+namespace {
+
+/**
+ * @brief Check whether or not a client holds the server's final state.
+ */
+bool caughtUp(const GameClient &client, const GameServer &server,
+              const Board &board) {
+  const std::vector<snake::SnakePart> &parts = server.getSnake().getParts();
+  if (!client.isSynced() || client.currentTick() != server.currentTick() ||
+      client.getParts().size() != parts.size())
+    return false;
+  for (size_t i = 0; i < parts.size(); i++)
+    if (client.getParts()[i] != board.cellOf(parts[i].getTrans()))
+      return false;
+  return true;
+}
+
+};  // namespace
+
+/**
+ * Accepted arguments:
+ * - `--port <n>` listens on loopback port n, netConstants::default_port by
+ *   default.
+ * - `--tick-rate <rate>` steps the game rate times per second, 20 by default.
+ * - `--ticks <n>` stops after n ticks, otherwise runs until killed.
+ * - `--board <width>x<height>` plays on a board of the given amount of cells,
+ *   as in the game.
+ * - `--length <n>` makes the Snake start each round with n parts, at most as
+ *   many as fit in a row of the board.
+ * - `--clients <n>` also runs n headless clients on the loopback interface,
+ *   steering with the autopilot, and reports the bandwidth and latency they
+ *   measured. Sessions with clients stop after 600 ticks by default.
+ * - `--loss <percent>` drops that share of the snapshots, to exercise how
+ *   clients catch up.
+ * - `--connect <port>` runs a single headless client of a server listening on
+ *   port instead, until that server goes silent.
+ * - `--trace <path>` records a Chrome trace of the session into path.
+ */
+int main(int argc, char *argv[]) {
+  logger::start();
+
+  uint16_t port = netConstants::default_port, connectPort = 0;
+  double rate = netConstants::default_tick_rate, loss = 0.0;
+  long ticks = -1;
+  int length = 3, clientCount = 0;
+  Board board;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      tracer::start(argv[++i]);
+      tracer::nameThread("main");
+    } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc)
+      port = (uint16_t)atoi(argv[++i]);
+    else if (strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc)
+      rate = atof(argv[++i]);
+    else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+      ticks = std::max(0L, atol(argv[++i]));
+    else if (strcmp(argv[i], "--length") == 0 && i + 1 < argc)
+      length = std::max(1, atoi(argv[++i]));
+    else if (strcmp(argv[i], "--clients") == 0 && i + 1 < argc)
+      clientCount = std::min(std::max(0, atoi(argv[++i])),
+                             netConstants::max_clients);
+    else if (strcmp(argv[i], "--loss") == 0 && i + 1 < argc)
+      loss = std::min(std::max(atof(argv[++i]) / 100.0, 0.0), 1.0);
+    else if (strcmp(argv[i], "--connect") == 0 && i + 1 < argc)
+      connectPort = (uint16_t)atoi(argv[++i]);
+    else if (strcmp(argv[i], "--board") == 0 && i + 1 < argc) {
+      int width, height;
+      int read = sscanf(argv[++i], "%dx%d", &width, &height);
+      if (read >= 1) board = Board{width, read == 2 ? height : width};
+    } else
+      logger::log(logger::level::WARNING, "Unknown argument %s", argv[i]);
+  }
+  if (ticks < 0) ticks = clientCount > 0 ? 600 : 0;
+  if (length > board.maxStartLength()) {
+    length = board.maxStartLength();
+    logger::log(logger::level::WARNING,
+                "The Snake can start with at most %d parts on this board",
+                length);
+  }
+
+  int status = 0;
+  if (connectPort != 0) {
+    GameClient client{connectPort};
+    std::atomic<bool> stop{false};
+    if (client.isOpen()) {
+      client.run(stop);
+      GameClient::reportHeader();
+      client.report("client");
+    } else
+      status = 1;
+  } else {
+    // each client holds a worker for the whole session
+    tasks::start(std::max((unsigned int)clientCount,
+                          taskConstants::min_workers));
+    GameServer server{port, board, length, loss};
+    std::vector<std::unique_ptr<GameClient>> clients;
+    std::vector<std::future<void>> running;
+    std::atomic<bool> stop{false};
+    for (int i = 0; i < clientCount && server.isOpen(); i++) {
+      clients.emplace_back(new GameClient{server.port()});
+      GameClient *client = clients.back().get();
+      running.push_back(tasks::async(tasks::priority::NORMAL,
+                                     [client, &stop] { client->run(stop); }));
+    }
+
+    if (server.isOpen()) {
+      logger::log(logger::level::INFO,
+                  "Server listening on port %u, at %.1f ticks/s",
+                  (unsigned)server.port(), rate);
+      server.run(rate, ticks);
+    } else
+      status = 1;
+
+    // the final snapshots are given time to arrive
+    std::this_thread::sleep_for(
+        std::chrono::duration<double>(netConstants::rejoin_interval));
+    stop = true;
+    for (std::future<void> &client : running) client.wait();
+
+    if (server.isOpen()) server.report();
+    if (!clients.empty()) {
+      size_t synced = 0;
+      GameClient::reportHeader();
+      for (size_t i = 0; i < clients.size(); i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "client %zu", i + 1);
+        clients[i]->report(name);
+        if (caughtUp(*clients[i], server, board)) synced++;
+      }
+      logger::log(logger::level::INFO,
+                  "%zu of %zu clients hold the server's final state", synced,
+                  clients.size());
+    }
+    tasks::stop();
+  }
+
+  tracer::stop();
+  logger::stop();
+  return status;
+}
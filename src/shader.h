@@ -9,22 +9,32 @@
 #ifndef SHADER_H
 #define SHADER_H
 
-#include <fstream>
-#include <iostream>
-#include <sstream>
+#include <cstring>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "Assets.h"
 #include "Include/glad/glad.h"
 #include "Include/glm/glm.hpp"
 #include "Include/glm/gtc/matrix_transform.hpp"
+#include "GLStats.h"
 #include "Include/glm/gtc/type_ptr.hpp"
+#include "Logger.h"
+#include "Tracer.h"
 
 /**
  * @brief Defines the methods for Shader compilation and behavior.
+ *
+ * The locations of the program's uniforms are looked up once, after linking,
+ * so that setting a uniform never asks the driver for its location.
  */
 class Shader {
   using SELF = Shader;
 
+  // every active uniform's name and location
+  std::vector<std::pair<std::string, GLint>> uniforms;
+
  public:
   GLuint ID;
 
@@ -34,72 +44,31 @@ class Shader {
    * @param vertexPath path to the vertex GLSL file
    * @param fragmentPath path to the fragment GLSL file
    *
-   * The given files are read, compiled and linked into a shader program.
+   * The given sources, embedded or read from disk, are compiled and linked
+   * into a shader program.
+   *
+   * Any errors are logged.
    *
-   * Any errors are logged to the console.
+   * @see assets::read
    */
   Shader(const char *vertexPath, const char *fragmentPath) {
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::ifstream vShaderFile;
-    std::ifstream fShaderFile;
-
-    vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-    try {
-      vShaderFile.open(vertexPath);
-      fShaderFile.open(fragmentPath);
-      std::stringstream vShaderStream, fShaderStream;
-      vShaderStream << vShaderFile.rdbuf();
-      fShaderStream << fShaderFile.rdbuf();
-      vShaderFile.close();
-      fShaderFile.close();
-      vertexCode = vShaderStream.str();
-      fragmentCode = fShaderStream.str();
-    } catch (const std::ifstream::failure &e) {
-      std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << std::endl;
-    }
-    const char *vShaderCode = vertexCode.c_str();
-    const char *fShaderCode = fragmentCode.c_str();
-
-    GLuint vertex, fragment;
-    int success;
-    char infoLog[512];
-
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vShaderCode, NULL);
-    glCompileShader(vertex);
-    glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
-    if (!success) {
-      glGetShaderInfoLog(vertex, 512, NULL, infoLog);
-      std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n"
-                << infoLog << std::endl;
-    }
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fShaderCode, NULL);
-    glCompileShader(fragment);
-    glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
-    if (!success) {
-      glGetShaderInfoLog(fragment, 512, NULL, infoLog);
-      std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n"
-                << infoLog << std::endl;
-    }
-
-    ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
-    glLinkProgram(ID);
-    glGetProgramiv(ID, GL_LINK_STATUS, &success);
-    if (!success) {
-      glGetProgramInfoLog(ID, 512, NULL, infoLog);
-      std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << std::endl;
-    }
-
-    glDetachShader(ID, vertex);
-    glDeleteShader(vertex);
-    glDetachShader(ID, fragment);
-    glDeleteShader(fragment);
+    assets::Blob vertexCode, fragmentCode;
+    assets::read(vertexPath, vertexCode);
+    assets::read(fragmentPath, fragmentCode);
+    compile(vertexCode, fragmentCode);
+  }
+  /**
+   * @brief Constructor for a shader, from sources already read.
+   *
+   * @param vertexCode the vertex GLSL source, or an empty Blob if it couldn't
+   * be read
+   * @param fragmentCode the fragment GLSL source, or an empty Blob if it
+   * couldn't be read
+   *
+   * Any errors are logged.
+   */
+  Shader(const assets::Blob &vertexCode, const assets::Blob &fragmentCode) {
+    compile(vertexCode, fragmentCode);
   }
 
   /**
@@ -112,14 +81,29 @@ class Shader {
     return *this;
   }
 
+  /**
+   * @brief Get the location of a uniform, as cached after linking.
+   *
+   * @param name uniform name
+   *
+   * @return the location, or -1 if the program has no such active uniform,
+   * which setting ignores
+   */
+  GLint location(const char *name) const {
+    for (const auto &uniform : uniforms)
+      if (strcmp(uniform.first.c_str(), name) == 0) return uniform.second;
+    return -1;
+  }
+
   /**
    * @brief Set a bool uniform.
    *
    * @param name uniform name
    * @param value given uniform value
    */
-  void setBool(const std::string &name, bool value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+  void setBool(const char *name, bool value) const {
+    glstats::countUniform();
+    glUniform1i(location(name), (int)value);
   }
   /**
    * @brief Set an int uniform.
@@ -127,8 +111,9 @@ class Shader {
    * @param name uniform name
    * @param value given uniform value
    */
-  void setInt(const std::string &name, int value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+  void setInt(const char *name, int value) const {
+    glstats::countUniform();
+    glUniform1i(location(name), value);
   }
   /**
    * @brief Set a float uniform.
@@ -136,8 +121,9 @@ class Shader {
    * @param name uniform name
    * @param value given uniform value
    */
-  void setFloat(const std::string &name, float value) const {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+  void setFloat(const char *name, float value) const {
+    glstats::countUniform();
+    glUniform1f(location(name), value);
   }
   /**
    * @brief Set a 2D vector uniform.
@@ -145,9 +131,9 @@ class Shader {
    * @param name uniform name
    * @param value given uniform value
    */
-  void setv2fv(const std::string &name, glm::vec2 vec) const {
-    glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1,
-                 glm::value_ptr(vec));
+  void setv2fv(const char *name, glm::vec2 vec) const {
+    glstats::countUniform();
+    glUniform2fv(location(name), 1, glm::value_ptr(vec));
   }
   /**
    * @brief Set a 4D vector uniform.
@@ -155,9 +141,9 @@ class Shader {
    * @param name uniform name
    * @param value given uniform value
    */
-  void setv4fv(const std::string &name, glm::vec4 vec) const {
-    glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1,
-                 glm::value_ptr(vec));
+  void setv4fv(const char *name, glm::vec4 vec) const {
+    glstats::countUniform();
+    glUniform4fv(location(name), 1, glm::value_ptr(vec));
   }
   /**
    * @brief Set a 4D matrix uniform.
@@ -165,8 +151,9 @@ class Shader {
    * @param name uniform name
    * @param value given uniform value
    */
-  void setm4fv(const std::string &name, const glm::mat4 &mat) const {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE,
+  void setm4fv(const char *name, const glm::mat4 &mat) const {
+    glstats::countUniform();
+    glUniformMatrix4fv(location(name), 1, GL_FALSE,
                        glm::value_ptr(mat));
   }
 
@@ -174,6 +161,84 @@ class Shader {
    * @brief Destructor for the Shader, deleting the shader program.
    */
   ~Shader() { glDeleteProgram(ID); }
+
+ private:
+  /**
+   * @brief Compile and link the program.
+   *
+   * @param vertexCode the vertex GLSL source
+   * @param fragmentCode the fragment GLSL source
+   */
+  void compile(const assets::Blob &vertexCode,
+               const assets::Blob &fragmentCode) {
+    tracer::Scope trace{"LOAD SHADER"};
+    // compiled empty when unread, so the failure also shows up below
+    const char *vShaderCode = "", *fShaderCode = "";
+    GLint vShaderLength = 0, fShaderLength = 0;
+    if (vertexCode.data == NULL || fragmentCode.data == NULL) {
+      logger::log(logger::level::ERROR,
+                  "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ");
+    } else {
+      vShaderCode = (const char *)vertexCode.data;
+      fShaderCode = (const char *)fragmentCode.data;
+      vShaderLength = (GLint)vertexCode.size;
+      fShaderLength = (GLint)fragmentCode.size;
+    }
+
+    GLuint vertex, fragment;
+    int success;
+    char infoLog[512];
+
+    vertex = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertex, 1, &vShaderCode, &vShaderLength);
+    glCompileShader(vertex);
+    glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
+    if (!success) {
+      glGetShaderInfoLog(vertex, 512, NULL, infoLog);
+      logger::log(logger::level::ERROR,
+                  "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n%s", infoLog);
+    }
+    fragment = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragment, 1, &fShaderCode, &fShaderLength);
+    glCompileShader(fragment);
+    glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
+    if (!success) {
+      glGetShaderInfoLog(fragment, 512, NULL, infoLog);
+      logger::log(logger::level::ERROR,
+                  "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n%s", infoLog);
+    }
+
+    ID = glCreateProgram();
+    glAttachShader(ID, vertex);
+    glAttachShader(ID, fragment);
+    glLinkProgram(ID);
+    glGetProgramiv(ID, GL_LINK_STATUS, &success);
+    if (!success) {
+      glGetProgramInfoLog(ID, 512, NULL, infoLog);
+      logger::log(logger::level::ERROR,
+                  "ERROR::SHADER::PROGRAM::LINKING_FAILED\n%s", infoLog);
+    }
+
+    glDetachShader(ID, vertex);
+    glDeleteShader(vertex);
+    glDetachShader(ID, fragment);
+    glDeleteShader(fragment);
+
+    GLint active = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &active);
+    for (GLint i = 0; i < active; i++) {
+      char name[128];
+      GLsizei length = 0;
+      GLint size;
+      GLenum type;
+      glGetActiveUniform(ID, (GLuint)i, sizeof(name), &length, &size, &type,
+                         name);
+      // arrays are listed by their first element
+      if (length > 3 && strcmp(name + length - 3, "[0]") == 0)
+        name[length - 3] = '\0';
+      uniforms.emplace_back(name, glGetUniformLocation(ID, name));
+    }
+  }
 };
 
 #endif
@@ -16,7 +16,9 @@ uniform sampler2D texture1;
 
 void main()
 {
-  FragColor = texture(texture1, texCoord);
-  if (FragColor.rgb == vec3(0,0,0)) discard;
+  // the atlas holds each texel's coverage in its only channel
+  float coverage = texture(texture1, texCoord).r;
+  if (coverage == 0.0) discard;
+  FragColor = vec4(vec3(coverage), 1.0);
 };
 
@@ -9,6 +9,9 @@
 #version 330 core
 
 layout (location = 0) in vec3 aPos;
+// where an instanced Snake part stood before the latest tick, and after it
+layout (location = 1) in vec3 aPrevious;
+layout (location = 2) in vec3 aCurrent;
 
 uniform mat4 model;
 uniform mat4 view;
@@ -16,11 +19,30 @@ uniform mat4 projection;
 
 uniform vec4 ourColor;
 
+// whether the model comes from the instance attributes instead of model
+uniform bool instanced;
+// fraction of the tick gone by
+uniform float tickAlpha;
+// size of each Snake part
+uniform float partScale;
+
 out vec4 sharedColor; 
 
 void main()
 {
-  gl_Position = projection * view * model * vec4(aPos, 1.0f);
+  mat4 world = model;
+  if (instanced) {
+    vec3 delta = aCurrent - aPrevious;
+    // a part wrapping around the board slides one cell past the edge it left
+    if (abs(delta.x) > 1.5f * partScale) delta.x = -sign(delta.x) * partScale;
+    if (abs(delta.z) > 1.5f * partScale) delta.z = -sign(delta.z) * partScale;
+    vec3 trans = tickAlpha < 1.0f ? aPrevious + delta * tickAlpha : aCurrent;
+    world = mat4(partScale, 0.0f, 0.0f, 0.0f,
+                 0.0f, partScale, 0.0f, 0.0f,
+                 0.0f, 0.0f, partScale, 0.0f,
+                 trans, 1.0f);
+  }
+  gl_Position = projection * view * world * vec4(aPos, 1.0f);
   sharedColor = ourColor;
 };
 
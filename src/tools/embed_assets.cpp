@@ -0,0 +1,221 @@
+/**
+ * @file embed_assets.cpp
+ * @copyright
+ * Copyright 2024 Rafael Spinassé
+ * Licensed under MIT license
+ *
+ * @brief Build step decoding the game's assets into a C++ source file.
+ *
+ * Usage: `embed_assets <output.cpp> <asset>...`
+ *
+ * Each asset is decoded by its extension: `.wav` sounds into their PCM
+ * samples, and anything else is kept as is. Assets missing on disk are
+ * skipped, and read by the game from its working directory instead.
+ *
+ * Usage: `embed_assets --atlas <image> <output.atlas>`
+ *
+ * Converts the font bitmap into a single channel atlas, see FontAtlas.h.
+ *
+ * @see Assets.h
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../FontAtlas.h"
+#include "../Include/stb_image/stb_image.h"
+#include "../constants.h"
+
+/**
+ * @brief An asset decoded for embedding.
+ */
+struct Decoded {
+  std::string path;
+  std::vector<unsigned char> data;
+  int channels = 0;
+  unsigned int rate = 0;
+  int bits = 0;
+};
+
+/**
+ * @brief Check whether or not a path ends with an extension.
+ */
+static bool endsWith(const std::string &path, const char *extension) {
+  size_t length = strlen(extension);
+  return path.size() >= length &&
+         path.compare(path.size() - length, length, extension) == 0;
+}
+
+static bool readFile(const char *path, std::vector<unsigned char> &data) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) return false;
+  unsigned char chunk[4096];
+  size_t got;
+  while ((got = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    data.insert(data.end(), chunk, chunk + got);
+  fclose(file);
+  return true;
+}
+
+static uint32_t little32(const unsigned char *bytes) {
+  return bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+static uint16_t little16(const unsigned char *bytes) {
+  return bytes[0] | bytes[1] << 8;
+}
+
+/**
+ * @brief Keeps the samples of a RIFF WAVE file, skipping every chunk but its
+ * format and data.
+ */
+static bool decodeWav(const std::vector<unsigned char> &file,
+                      Decoded &asset) {
+  if (file.size() < 12 || memcmp(&file[0], "RIFF", 4) != 0 ||
+      memcmp(&file[8], "WAVE", 4) != 0)
+    return false;
+
+  bool format = false;
+  size_t position = 12;
+  while (position + 8 <= file.size()) {
+    const unsigned char *chunk = &file[position];
+    size_t size = little32(chunk + 4);
+    position += 8;
+    if (size > file.size() - position) size = file.size() - position;
+
+    if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+      asset.channels = little16(chunk + 10);
+      asset.rate = little32(chunk + 12);
+      asset.bits = little16(chunk + 22);
+      format = true;
+    } else if (memcmp(chunk, "data", 4) == 0) {
+      asset.data.assign(file.begin() + position,
+                        file.begin() + position + size);
+      return format;
+    }
+    // chunks are padded to an even size
+    position += size + (size & 1);
+  }
+  return false;
+}
+
+static bool decode(const char *path, Decoded &asset) {
+  asset.path = path;
+  while (asset.path.compare(0, 2, "./") == 0) asset.path.erase(0, 2);
+
+  std::vector<unsigned char> file;
+  if (!readFile(path, file)) return false;
+  if (endsWith(asset.path, ".wav")) return decodeWav(file, asset);
+  asset.data.swap(file);
+  return true;
+}
+
+/**
+ * @brief Converts an image into an atlas, with fontConstants' glyph metrics.
+ *
+ * Each texel's coverage is its brightest channel, so that any texel but black
+ * ones stays visible, as with the original bitmap.
+ */
+static int convertAtlas(const char *imagePath, const char *atlasPath) {
+  int width, height, channels;
+  stbi_set_flip_vertically_on_load(true);
+  unsigned char *pixels = stbi_load(imagePath, &width, &height, &channels, 0);
+  if (pixels == NULL) {
+    fprintf(stderr, "%s couldn't be decoded: %s\n", imagePath,
+            stbi_failure_reason());
+    return 1;
+  }
+
+  atlas::Header header;
+  memcpy(header.magic, atlas::magic, sizeof(atlas::magic));
+  header.version = atlas::version;
+  header.width = width;
+  header.height = height;
+  header.glyphWidth = fontConstants::font_char_width;
+  header.glyphHeight = fontConstants::font_char_height;
+  header.numberSeqStart = fontConstants::number_seq_start;
+  header.letterSeqStart = fontConstants::letter_seq_start;
+
+  std::vector<unsigned char> coverage((size_t)width * height);
+  for (size_t i = 0; i < coverage.size(); i++) {
+    const unsigned char *texel = pixels + i * channels;
+    unsigned char brightest = 0;
+    // a fourth channel is alpha, not brightness
+    for (int c = 0; c < channels && c < 3; c++)
+      if (texel[c] > brightest) brightest = texel[c];
+    coverage[i] = brightest;
+  }
+  stbi_image_free(pixels);
+
+  FILE *out = fopen(atlasPath, "wb");
+  if (out == NULL) {
+    perror(atlasPath);
+    return 1;
+  }
+  fwrite(&header, sizeof(header), 1, out);
+  fwrite(coverage.data(), 1, coverage.size(), out);
+  if (fclose(out) != 0) {
+    perror(atlasPath);
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Writes an asset's bytes as an aligned array, with the null byte
+ * Assets.h promises after them.
+ */
+static void writeArray(FILE *out, size_t index, const Decoded &asset) {
+  fprintf(out, "\n// %s\nalignas(16) constexpr unsigned char asset%zu[] = {",
+          asset.path.c_str(), index);
+  for (size_t i = 0; i < asset.data.size(); i++)
+    fprintf(out, "%s%u,", i % 20 == 0 ? "\n" : "", asset.data[i]);
+  fprintf(out, "\n0};\n");
+}
+
+int main(int argc, char *argv[]) {
+  if (argc == 4 && strcmp(argv[1], "--atlas") == 0)
+    return convertAtlas(argv[2], argv[3]);
+  if (argc < 2) {
+    fprintf(stderr,
+            "Usage: %s <output.cpp> <asset>...\n"
+            "       %s --atlas <image> <output.atlas>\n",
+            argv[0], argv[0]);
+    return 1;
+  }
+
+  std::vector<Decoded> assets;
+  for (int i = 2; i < argc; i++) {
+    Decoded asset;
+    if (decode(argv[i], asset))
+      assets.push_back(asset);
+    else
+      fprintf(stderr, "%s: skipping %s, which couldn't be decoded\n", argv[0],
+              argv[i]);
+  }
+
+  FILE *out = fopen(argv[1], "w");
+  if (out == NULL) {
+    perror(argv[1]);
+    return 1;
+  }
+  fprintf(out,
+          "// Generated by tools/embed_assets.cpp, do not edit.\n"
+          "#include \"Assets.h\"\n\nnamespace {\n");
+  for (size_t i = 0; i < assets.size(); i++) writeArray(out, i, assets[i]);
+  fprintf(out, "\n};  // namespace\n\nconst assets::Embedded "
+               "assets::embedded[] = {\n");
+  for (size_t i = 0; i < assets.size(); i++) {
+    const Decoded &asset = assets[i];
+    fprintf(out, "    {\"%s\", asset%zu, %zu, %d, %u, %d},\n",
+            asset.path.c_str(), i, asset.data.size(), asset.channels,
+            asset.rate, asset.bits);
+  }
+  fprintf(out, "    {NULL, NULL, 0, 0, 0, 0}};\n");
+
+  bool written = fclose(out) == 0;
+  if (!written) perror(argv[1]);
+  return written ? 0 : 1;
+}